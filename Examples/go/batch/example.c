@@ -0,0 +1,11 @@
+/* File : example.c */
+
+#include "example.h"
+
+double particle_x(const Particle *p) {
+  return p->x;
+}
+
+double particle_energy(const Particle *p, double vx, double vy) {
+  return 0.5 * p->mass * (vx * vx + vy * vy);
+}
@@ -0,0 +1,9 @@
+/* File : example.h */
+
+typedef struct Particle {
+  double x, y;
+  double mass;
+} Particle;
+
+double particle_x(const Particle *p);
+double particle_energy(const Particle *p, double vx, double vy);
@@ -0,0 +1,17 @@
+/* File : example.i */
+%module example
+
+/* Generate Particle_xBatch and Particle_energyBatch, which make many
+   calls for the price of a single cgo call.  The member variable
+   accessors, such as Particle.GetX, never block or call back into Go,
+   so they are marked as leaf functions, which use a cheaper call. */
+%feature("go:batch") particle_x;
+%feature("go:batch") particle_energy;
+%feature("go:leaf") Particle::x;
+%feature("go:leaf") Particle::y;
+
+%{
+#include "example.h"
+%}
+
+%include "example.h"
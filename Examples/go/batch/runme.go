@@ -0,0 +1,79 @@
+// This example compares the cost of calling small C functions from Go
+// one at a time, as leaf functions, and in batches.
+
+package main
+
+import (
+	. "./example"
+	"fmt"
+	"testing"
+)
+
+const count = 1000
+
+func main() {
+	particles := make([]Particle, count)
+	for i := range particles {
+		p := NewParticle()
+		p.SetX(float64(i))
+		p.SetY(float64(-i))
+		p.SetMass(2)
+		particles[i] = p
+	}
+
+	// Each argument struct holds the C pointer and receives the result.
+	xargs := make([]Particle_xBatchArgs, count)
+	eargs := make([]Particle_energyBatchArgs, count)
+	for i, p := range particles {
+		xargs[i].Arg1 = p.Swigcptr()
+		eargs[i] = Particle_energyBatchArgs{Arg1: p.Swigcptr(), Arg2: 1, Arg3: 2}
+	}
+
+	// Check that the batched calls give the same results.
+	Particle_xBatch(xargs)
+	Particle_energyBatch(eargs)
+	for i, p := range particles {
+		if xargs[i].Result != Particle_x(p) || xargs[i].Result != p.GetX() {
+			panic("Particle_xBatch result differs")
+		}
+		if eargs[i].Result != Particle_energy(p, 1, 2) {
+			panic("Particle_energyBatch result differs")
+		}
+	}
+
+	report := func(name string, f func()) {
+		r := testing.Benchmark(func(b *testing.B) {
+			for n := 0; n < b.N; n++ {
+				f()
+			}
+		})
+		fmt.Printf("%-32s %8d ns per %d calls\n", name, r.NsPerOp(), count)
+	}
+
+	var sum float64
+	report("Particle_x (one cgo call each)", func() {
+		for _, p := range particles {
+			sum += Particle_x(p)
+		}
+	})
+	report("GetX (leaf function)", func() {
+		for _, p := range particles {
+			sum += p.GetX()
+		}
+	})
+	report("Particle_xBatch", func() {
+		Particle_xBatch(xargs)
+	})
+	report("Particle_energy (one each)", func() {
+		for _, p := range particles {
+			sum += Particle_energy(p, 1, 2)
+		}
+	})
+	report("Particle_energyBatch", func() {
+		Particle_energyBatch(eargs)
+	})
+
+	for _, p := range particles {
+		DeleteParticle(p)
+	}
+}
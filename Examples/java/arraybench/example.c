@@ -0,0 +1,25 @@
+/* File : example.c */
+
+#include "example.h"
+
+double sum_copy(const float *data, size_t n) {
+  double sum = 0;
+  size_t i;
+  for (i = 0; i < n; i++)
+    sum += data[i];
+  return sum;
+}
+
+double sum_critical(const float *data, size_t n) {
+  return sum_copy(data, n);
+}
+
+double sum_direct(const float *data, size_t n) {
+  return sum_copy(data, n);
+}
+
+void scale_direct(float *data, size_t n, float factor) {
+  size_t i;
+  for (i = 0; i < n; i++)
+    data[i] *= factor;
+}
@@ -0,0 +1,8 @@
+/* File : example.h */
+
+#include <stddef.h>
+
+double sum_copy(const float *data, size_t n);
+double sum_critical(const float *data, size_t n);
+double sum_direct(const float *data, size_t n);
+void scale_direct(float *data, size_t n, float factor);
@@ -0,0 +1,21 @@
+/* File : example.i */
+%module example
+
+%include "arrays_java.i"
+
+/* Three ways of passing a float array to C:
+ *   sum_copy     - default float[] mapping, elements copied in and out
+ *   sum_critical - float[] accessed in place with GetPrimitiveArrayCritical
+ *   sum_direct   - direct java.nio.FloatBuffer, no copying or pinning at all */
+%apply float[] { const float *data };
+%apply (float *CRITICAL, size_t LENGTH) { (const float *critical_data, size_t n) };
+%apply (float *DIRECT, size_t LENGTH) { (const float *direct_data, size_t n), (float *data, size_t n) };
+
+%{
+#include "example.h"
+%}
+
+double sum_copy(const float *data, size_t n);
+double sum_critical(const float *critical_data, size_t n);
+double sum_direct(const float *direct_data, size_t n);
+void scale_direct(float *data, size_t n, float factor);
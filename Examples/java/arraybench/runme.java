@@ -0,0 +1,76 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+
+public class runme {
+
+  static {
+    try {
+	System.loadLibrary("example");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  static final int WARMUP = 2000;
+  static final int ITERATIONS = 20000;
+
+  interface Bench {
+    double run();
+  }
+
+  // Time a benchmark after a warmup phase so that the JIT has compiled the call path,
+  // in the manner of a JMH average time benchmark. Returns the checksum so the calls
+  // cannot be optimised away.
+  static double time(String name, int size, Bench bench) {
+    double check = 0;
+    for (int i = 0; i < WARMUP; i++)
+      check += bench.run();
+    long start = System.nanoTime();
+    for (int i = 0; i < ITERATIONS; i++)
+      check += bench.run();
+    long elapsed = System.nanoTime() - start;
+    System.out.println("  " + name + ": " + (elapsed / ITERATIONS) + " ns/call (" + size + " floats)");
+    return check;
+  }
+
+  public static void main(String argv[]) {
+    double check = 0;
+    int sizes[] = { 16, 1024, 65536 };
+
+    for (int s = 0; s < sizes.length; s++) {
+      final int size = sizes[s];
+      final float array[] = new float[size];
+      final FloatBuffer buffer = ByteBuffer.allocateDirect(size * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      for (int i = 0; i < size; i++) {
+        array[i] = i;
+        buffer.put(i, i);
+      }
+
+      if (example.sum_copy(array, size) != example.sum_critical(array) ||
+          example.sum_copy(array, size) != example.sum_direct(buffer))
+        throw new RuntimeException("sums differ");
+
+      System.out.println(size + " element array:");
+      check += time("float[] (copy)        ", size, new Bench() { public double run() { return example.sum_copy(array, size); } });
+      check += time("float[] (CRITICAL)    ", size, new Bench() { public double run() { return example.sum_critical(array); } });
+      check += time("FloatBuffer (DIRECT)  ", size, new Bench() { public double run() { return example.sum_direct(buffer); } });
+    }
+
+    // C writes straight into the direct buffer's memory
+    FloatBuffer buffer = ByteBuffer.allocateDirect(4 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+    buffer.put(0, 1.5f);
+    example.scale_direct(buffer, 2.0f);
+    if (buffer.get(0) != 3.0f)
+      throw new RuntimeException("scale_direct failed");
+
+    try {
+      example.sum_direct(FloatBuffer.allocate(4));
+      throw new RuntimeException("heap buffer not rejected");
+    } catch (IllegalArgumentException e) {
+    }
+
+    System.out.println("checksum " + check);
+  }
+}
@@ -0,0 +1,25 @@
+%module(directors="1") Simple
+
+/* Use the director lookup table rather than dynamic_cast, so that it is
+   exercised by the threads in runme.py. */
+%begin %{
+#define SWIG_DIRECTOR_NORTTI
+%}
+
+%feature("director") MyClass;
+
+%inline %{
+class MyClass {
+public:
+    MyClass () {}
+    virtual ~MyClass () {}
+    virtual int func (int i) { return i; }
+};
+
+int call (MyClass *x, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += x->func(i);
+    return sum;
+}
+%}
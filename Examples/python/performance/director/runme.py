@@ -0,0 +1,31 @@
+#!/usr/bin/env
+
+import sys
+import threading
+sys.path.append('..')
+import harness
+
+nthreads = 8
+
+def work (mod) :
+    class MyDirector (mod.MyClass) :
+        def func (self, i) :
+            return i
+    # director creation, each registered in the director lookup table
+    for i in range(20000) :
+        x = MyDirector()
+        x.__disown__()
+        mod.call(x, 1)
+    # upcalls, each looking up the director from the C++ pointer
+    x = MyDirector()
+    for i in range(20) :
+        mod.call(x, 10000)
+
+def proc (mod) :
+    threads = [threading.Thread(target=work, args=(mod,)) for i in range(nthreads)]
+    for t in threads :
+        t.start()
+    for t in threads :
+        t.join()
+
+harness.run(proc)
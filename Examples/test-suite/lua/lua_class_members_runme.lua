@@ -0,0 +1,64 @@
+require("import")	-- the import fn
+import("lua_class_members")	-- import code
+
+-- catch "undefined" global variables
+local env = _ENV -- Lua 5.2
+if not env then env = getfenv () end -- Lua 5.1
+setmetatable(env, {__index=function (t,i) error("undefined global variable `"..i.."'",2) end})
+
+lcm = lua_class_members
+
+-- attributes & methods of the class itself
+b = lcm.Base()
+assert(b.base_x == 1)
+b.base_x = 7
+assert(b.base_x == 7)
+assert(b:name() == "Base")
+assert(b:base_only() == 10)
+assert(b.unknown == nil)
+
+-- inherited attributes & methods, including virtual ones, at several levels
+d = lcm.Derived()
+assert(d.base_x == 1 and d.derived_y == 2)
+d.base_x = 8
+d.derived_y = 9
+assert(d.base_x == 8 and d.derived_y == 9)
+assert(d:name() == "Derived")
+assert(d:base_only() == 10)
+m = lcm.MoreDerived()
+assert(m.base_x == 1 and m.derived_y == 2 and m.more_z == 3)
+m.base_x = 11
+assert(m.base_x == 11)
+assert(m:name() == "Derived")
+assert(m:base_only() == 10)
+assert(b.name(m) == "Derived")
+
+-- read only attributes cannot be set
+assert(d.read_only == 5)
+assert(not pcall(function() d.read_only = 6 end))
+assert(d.read_only == 5)
+-- unknown names are ignored
+d.unknown = 1
+assert(d.unknown == nil)
+
+-- static members
+assert(lcm.Base_static_count == 3)
+lcm.Base_static_count = 10
+lcm.Derived()
+assert(lcm.Base_static_count == 11)
+assert(lcm.Base_twice(21) == 42)
+
+-- __getitem/__setitem are used for names not in the class
+g = lcm.Grid()
+assert(g.width == 4)
+assert(g[0] == 0 and g[1] == 1.5 and g[3] == 4.5)
+g[2] = 10
+assert(g[2] == 10)
+assert(g:sum() == 16)
+g.width = 5
+assert(g.width == 5)
+assert(g[1] == 1.5)
+
+-- functions added to the .fn table at runtime are found too
+getmetatable(d)[".fn"].triple_y = function(self) return 3 * self.derived_y end
+assert(d:triple_y() == 27)
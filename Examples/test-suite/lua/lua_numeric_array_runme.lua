@@ -0,0 +1,57 @@
+require("import")	-- the import fn
+import("lua_numeric_array")	-- import code
+
+-- catch "undefined" global variables
+local env = _ENV -- Lua 5.2
+if not env then env = getfenv () end -- Lua 5.1
+setmetatable(env, {__index=function (t,i) error("undefined global variable `"..i.."'",2) end})
+
+na = lua_numeric_array
+
+-- from_table / to_table
+a = na.doubleArray(8)
+for i=0,7 do a[i] = -1 end
+a:from_table({1.5, 2.5, 3.5})
+assert(a[0] == 1.5 and a[1] == 2.5 and a[2] == 3.5 and a[3] == -1)
+a:from_table({7, 8}, 5)
+assert(a[4] == -1 and a[5] == 7 and a[6] == 8 and a[7] == -1)
+t = a:to_table(3)
+assert(#t == 3 and t[1] == 1.5 and t[3] == 3.5)
+t = a:to_table(2, 5)
+assert(#t == 2 and t[1] == 7 and t[2] == 8)
+assert(#a:to_table(0) == 0)
+assert(na.sum_doubles(a:cast(), 3) == 7.5)
+
+i = na.intArray(4)
+i:from_table({1, 2, 3, 4})
+t = i:to_table(4)
+assert(t[1] == 1 and t[4] == 4)
+
+-- to_blob / copy_from_blob
+s = a:to_blob(3)
+assert(#s == 3 * #a:to_blob(1))
+b = na.doubleArray(8)
+for k=0,7 do b[k] = 0 end
+assert(b:copy_from_blob(s, 8) == 3)
+assert(b[0] == 1.5 and b[1] == 2.5 and b[2] == 3.5 and b[3] == 0)
+-- count limits the copy
+assert(b:copy_from_blob(a:to_blob(8), 2, 4) == 2)
+assert(b[3] == 0 and b[4] == 1.5 and b[5] == 2.5 and b[6] == 0)
+assert(b:copy_from_blob(s, 0) == 0)
+-- partial elements are not copied
+assert(b:copy_from_blob(string.sub(s, 1, #s - 1), 8) == 2)
+-- a negative count is an error
+assert(a:to_blob(0) == "")
+assert(not pcall(function() a:to_blob(-1) end))
+
+-- non numbers are an error
+assert(not pcall(function() i:from_table({1, "x"}) end))
+
+-- NAME_blob: memory held in the userdata
+c = na.doubleArray_blob(4)
+assert(c[0] == 0 and c[3] == 0)
+c:from_table({1, 2, 3, 4})
+assert(c[3] == 4)
+assert(na.sum_doubles(c:cast(), 4) == 10)
+c = nil
+collectgarbage()
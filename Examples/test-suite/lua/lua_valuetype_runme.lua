@@ -0,0 +1,46 @@
+require("import")	-- the import fn
+import("lua_valuetype")	-- import code
+
+-- catch "undefined" global variables
+local env = _ENV -- Lua 5.2
+if not env then env = getfenv () end -- Lua 5.1
+setmetatable(env, {__index=function (t,i) error("undefined global variable `"..i.."'",2) end})
+
+e = lua_valuetype.Entity()
+
+-- values are copied into the userdata
+v = e:get_pos()
+assert(v.x == 1 and v.y == 2 and v.z == 3)
+v.x = 10
+assert(e.pos.x == 1)
+assert(lua_valuetype.vec3_sum(v) == 15)
+assert(not rawequal(e:get_pos(), e:get_pos()))
+
+-- non owning wrappers of a value type are reused for the same pointer
+p = e.pos
+assert(rawequal(p, e.pos))
+assert(rawequal(p, e:ptr_pos()))
+p.y = 20
+assert(e.pos.y == 20)
+assert(e:get_pos().y == 20)
+assert(lua_valuetype.vec3_sum(e.pos) == 24)
+
+-- a wrapper is no longer reused once it has been collected
+p = nil
+collectgarbage()
+assert(e.pos.y == 20)
+
+-- owned objects are never shared
+o = e:own_pos()
+assert(not rawequal(o, e:own_pos()))
+assert(not rawequal(o, e.pos))
+assert(o.y == 20)
+
+-- other classes get a new wrapper every time
+assert(not rawequal(e.other, e.other))
+assert(e.other.i == 4)
+
+-- different objects have different wrappers
+e2 = lua_valuetype.Entity()
+assert(not rawequal(e.pos, e2.pos))
+assert(e2.pos.y == 2)
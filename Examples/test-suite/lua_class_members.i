@@ -0,0 +1,36 @@
+/* Tests the lookup of class members in Lua through the flattened .members table */
+%module lua_class_members
+
+%inline %{
+struct Base {
+  int base_x;
+  static int static_count;
+  static int twice(int i) { return 2 * i; }
+  Base() : base_x(1) { static_count++; }
+  virtual ~Base() {}
+  virtual const char *name() const { return "Base"; }
+  int base_only() const { return 10; }
+};
+int Base::static_count = 0;
+
+struct Derived : Base {
+  int derived_y;
+  const int read_only;
+  Derived() : derived_y(2), read_only(5) {}
+  virtual const char *name() const { return "Derived"; }
+};
+
+struct MoreDerived : Derived {
+  int more_z;
+  MoreDerived() : more_z(3) {}
+};
+
+struct Grid {
+  int width;
+  double cells[4];
+  Grid() : width(4) { for (int i = 0; i < 4; i++) cells[i] = i * 1.5; }
+  double __getitem__(int i) const { return cells[i]; }
+  void __setitem__(int i, double d) { cells[i] = d; }
+  double sum() const { return cells[0] + cells[1] + cells[2] + cells[3]; }
+};
+%}
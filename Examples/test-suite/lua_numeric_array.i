@@ -0,0 +1,17 @@
+/* Tests %numeric_array_class in the Lua carrays.i */
+%module lua_numeric_array
+
+%include <carrays.i>
+
+%numeric_array_class(double, doubleArray);
+%numeric_array_class(int, intArray);
+
+%inline %{
+double sum_doubles(const double *a, int n) {
+  double total = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    total += a[i];
+  return total;
+}
+%}
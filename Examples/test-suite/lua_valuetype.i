@@ -0,0 +1,26 @@
+/* Tests %lua_valuetype: inline copies for values and reused non owning wrappers */
+%module lua_valuetype
+
+%lua_valuetype(Vec3);
+%newobject Entity::own_pos;
+
+%inline %{
+struct Vec3 {
+  double x, y, z;
+};
+
+struct Other {
+  int i;
+};
+
+struct Entity {
+  Vec3 pos;
+  Other other;
+  Entity() { pos.x = 1; pos.y = 2; pos.z = 3; other.i = 4; }
+  Vec3 get_pos() const { return pos; }
+  Vec3 *ptr_pos() { return &pos; }
+  Vec3 *own_pos() { return new Vec3(pos); }
+};
+
+double vec3_sum(const Vec3 &v) { return v.x + v.y + v.z; }
+%}
@@ -0,0 +1,29 @@
+%module preproc_cache
+
+/* Built twice with -cachedir, so the second module is generated from the
+   preprocessor cache. The parser preprocesses %inline code after the cached
+   output has been returned, and the macros must still be expanded there. */
+
+%{
+#define DECLARE(name) int name(void) { return 42; }
+#define TWICE(x) (2 * (x))
+#define FIRST(x, ...) x
+#define ZERO() 0
+%}
+
+#define DECLARE(name) int name(void) { return 42; }
+#define TWICE(x) (2 * (x))
+#define FIRST(x, ...) x
+#define ZERO() 0
+
+%define %declare_twice(name)
+%inline %{ int name(int x) { return TWICE(x); } %}
+%enddef
+
+%inline %{
+DECLARE(answer)
+int first(void) { return FIRST(1, 2, 3); }
+int zero(void) { return ZERO(); }
+%}
+
+%declare_twice(twice)
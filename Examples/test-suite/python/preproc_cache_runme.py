@@ -0,0 +1,10 @@
+from preproc_cache import *
+
+if answer() != 42:
+  raise RuntimeError("answer")
+if first() != 1:
+  raise RuntimeError("first")
+if zero() != 0:
+  raise RuntimeError("zero")
+if twice(21) != 42:
+  raise RuntimeError("twice")
@@ -0,0 +1,55 @@
+from python_fastcall import *
+
+def check(got, expected):
+  if got != expected:
+    raise RuntimeError("got %r, expected %r" % (got, expected))
+
+def check_error(f, message, *args, **kwargs):
+  try:
+    f(*args, **kwargs)
+  except TypeError as e:
+    if message not in str(e):
+      raise RuntimeError("unexpected message '%s', expected '%s'" % (e, message))
+  else:
+    raise RuntimeError("no TypeError raised, expected '%s'" % message)
+
+# positional and keyword arguments
+check(sub(5), 5)
+check(sub(5, 2), 3)
+check(sub(5, b=2), 3)
+check(sub(a=5, b=2), 3)
+check(sub(b=2, a=5), 3)
+check(sum3(1), 111)
+check(sum3(1, c=3), 14)
+check(sum3(c=3, a=1), 14)
+check(noargs(), 42)
+
+# the keyword names are interned on first use, so look them up again with
+# names built at runtime, which are not the interned objects
+kw = dict([("".join(["b"]), 7), ("".join(["a"]), 9)])
+check(sub(**kw), 2)
+check(sub(**kw), 2)
+
+# methods, constructors and static methods
+c = Calc(base=10)
+check(c.base, 10)
+check(c.add(1), 12)
+check(c.add(1, b=5), 16)
+check(c.add(b=5, a=1), 16)
+check(Calc.twice(a=4), 8)
+
+# overloaded functions only take positional arguments
+check(over(3), 3)
+check(over(1.0, 2), 3)
+
+# errors
+check_error(sub, "unexpected keyword argument 'c'", 1, c=2)
+check_error(sub, "unexpected keyword argument 'c'", a=1, c=2)
+check_error(sub, "missing required argument 'a'", b=2)
+check_error(sum3, "missing required argument 'a'", c=2)
+check_error(sub, "multiple values for argument 'a'", 1, a=2)
+check_error(sub, "expected at least 1 arguments, got 0")
+check_error(sub, "expected at most 2 arguments, got 3", 1, 2, 3)
+check_error(noargs, "keyword argument", a=1)
+check_error(c.add, "unexpected keyword argument 'c'", 1, c=2)
+check_error(c.add, "missing required argument 'a'", b=2)
@@ -0,0 +1,67 @@
+import weakref
+import python_fastthis
+from python_fastthis import Base, Derived
+
+if not issubclass(Base, python_fastthis._SwigPyProxy):
+  raise RuntimeError("Base does not derive from _SwigPyProxy")
+
+b = Base(3)
+if b.x != 3 or b.value() != 3:
+  raise RuntimeError("wrong Base value")
+b.x = 5
+if b.x != 5 or python_fastthis.get_value(b) != 5:
+  raise RuntimeError("wrong Base value after set")
+
+# 'this' lives in the slot, not in the instance __dict__
+if "this" in b.__dict__:
+  raise RuntimeError("'this' stored in the instance __dict__")
+if b.this is None or not b.thisown:
+  raise RuntimeError("wrong 'this' or 'thisown'")
+
+# the instance still has a __dict__ and can be weakly referenced
+b.extra = 10
+if b.extra != 10:
+  raise RuntimeError("instance attribute not kept")
+r = weakref.ref(b)
+if r() is not b:
+  raise RuntimeError("weakref does not refer to the instance")
+
+d = Derived(1, 2)
+if d.value() != 3 or python_fastthis.get_value(d) != 3:
+  raise RuntimeError("wrong Derived value")
+
+c = b.clone()
+if not c.thisown or c.value() != 5:
+  raise RuntimeError("wrong clone")
+
+m = python_fastthis.make_derived(4, 5)
+if not isinstance(m, Base) or m.value() != 9:
+  raise RuntimeError("wrong make_derived result")
+
+s = python_fastthis.same(b)
+if s.x != 5:
+  raise RuntimeError("wrong result from same")
+if s.thisown:
+  raise RuntimeError("returned reference is owned")
+
+b.thisown = 0
+if b.thisown:
+  raise RuntimeError("thisown not cleared")
+b.thisown = 1
+
+# Python subclasses of the proxies work like the proxies themselves
+class PyDerived(Derived):
+  def __init__(self):
+    Derived.__init__(self, 10, 20)
+    self.name = "py"
+
+p = PyDerived()
+if python_fastthis.get_value(p) != 30 or p.name != "py":
+  raise RuntimeError("wrong PyDerived value")
+
+# objects which are not proxies are still rejected
+try:
+  python_fastthis.get_value(object())
+  raise RuntimeError("object() accepted as Base")
+except TypeError:
+  pass
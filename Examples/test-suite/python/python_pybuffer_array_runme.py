@@ -0,0 +1,37 @@
+import array
+from python_pybuffer_array import *
+
+def check(got, expected):
+  if got != expected:
+    raise RuntimeError("got %r, expected %r" % (got, expected))
+
+def check_rejected(f, *args):
+  try:
+    f(*args)
+  except TypeError:
+    pass
+  else:
+    raise RuntimeError("buffer of the wrong format accepted")
+
+# buffers of the given format are accepted
+check(sum(array.array('d', [1.0, 2.0, 3.0])), 6.0)
+check(sum(array.array('d')), 0.0)
+check(sum(memoryview(array.array('d', [0.5, 0.25]))), 0.75)
+check(isum(array.array('i', [1, 2, 3])), 6)
+
+a = array.array('d', [1.0, 2.0])
+scale(a, 3.0)
+check(a.tolist(), [3.0, 6.0])
+
+# buffers of items of another format are rejected, even with the same size
+check_rejected(sum, array.array('q', [1, 2, 3]))
+check_rejected(sum, array.array('f', [1.0, 2.0]))
+check_rejected(sum, bytearray(16))
+check_rejected(isum, array.array('f', [1.0, 2.0]))
+check_rejected(isum, array.array('d', [1.0]))
+check_rejected(sum, [1.0, 2.0])
+
+# the mutable version also requires a writable buffer
+check_rejected(scale, array.array('q', [1, 2]), 2.0)
+check_rejected(scale, bytes(bytearray(16)), 2.0)
+check_rejected(scale, memoryview(array.array('d', [1.0])).toreadonly() if hasattr(memoryview, "toreadonly") else (), 2.0)
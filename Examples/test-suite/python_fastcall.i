@@ -0,0 +1,24 @@
+%module python_fastcall
+
+/*
+ Built with -fastcall, where keyword arguments are matched against the
+ interned names of a static keyword table rather than unpacked from a dict.
+*/
+
+%kwargs;
+
+%inline %{
+int sub(int a, int b = 0) { return a - b; }
+int sum3(int a, int b = 10, int c = 100) { return a + b + c; }
+int noargs() { return 42; }
+
+struct Calc {
+  int base;
+  Calc(int base = 0) : base(base) {}
+  int add(int a, int b = 1) const { return base + a + b; }
+  static int twice(int a) { return 2 * a; }
+};
+
+int over(int a) { return a; }
+int over(double a, int b) { return (int)a + b; }
+%}
@@ -0,0 +1,30 @@
+%module python_fastthis
+
+/*
+ Built with -fastthis, which makes the proxy classes derive from
+ _SwigPyProxy and keep 'this' in a slot instead of in the instance
+ __dict__.
+*/
+
+%newobject Base::clone;
+%newobject make_derived;
+
+%inline %{
+struct Base {
+  int x;
+  Base(int x = 0) : x(x) {}
+  virtual ~Base() {}
+  virtual int value() const { return x; }
+  Base *clone() const { return new Base(x); }
+};
+
+struct Derived : Base {
+  int y;
+  Derived(int x = 0, int y = 0) : Base(x), y(y) {}
+  virtual int value() const { return x + y; }
+};
+
+int get_value(const Base *b) { return b->value(); }
+Base *make_derived(int x, int y) { return new Derived(x, y); }
+Base *same(Base *b) { return b; }
+%}
@@ -0,0 +1,30 @@
+%module python_pybuffer_array
+%include <pybuffer.i>
+
+%pybuffer_array(const double *data, size_t n, "d");
+%pybuffer_array(const int *idata, size_t n, "i");
+%pybuffer_mutable_array(double *mdata, size_t n, "d");
+
+%inline %{
+double sum(const double *data, size_t n) {
+  double s = 0;
+  size_t i;
+  for (i = 0; i < n; ++i)
+    s += data[i];
+  return s;
+}
+
+int isum(const int *idata, size_t n) {
+  int s = 0;
+  size_t i;
+  for (i = 0; i < n; ++i)
+    s += idata[i];
+  return s;
+}
+
+void scale(double *mdata, size_t n, double factor) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    mdata[i] *= factor;
+}
+%}
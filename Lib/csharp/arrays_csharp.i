@@ -49,6 +49,22 @@
  *   %csmethodmodifiers myArrayCopy "public unsafe";
  *   void myArrayCopy( int *sourceArray, int* targetArray, int nitems );
  *
+ * Span approach
+ * -------------
+ * Array typemaps taking a System.Span<T> or System.ReadOnlySpan<T> (.NET Core 2.1 or
+ * later, or the System.Memory package). The span is passed by reference to its first
+ * element, which the p/invoke marshaler pins for the duration of the call, so like the
+ * fixed arrays there is no copying, but no unsafe code is needed. Arrays convert
+ * implicitly to spans, so these methods can also be called with a C# array, or with a
+ * slice of one or stack/native memory. The caveats given for the pinning approach apply.
+ *
+ * Example usage:
+ *
+ *   %include "arrays_csharp.i"
+ *   %apply float READONLYSPAN[] { const float* source }
+ *   %apply float SPAN[] { float* target }
+ *   void scale( const float* source, float* target, int nitems, float factor );
+ *
  * ----------------------------------------------------------------------------- */
 
 %define CSHARP_ARRAYS( CTYPE, CSTYPE )
@@ -135,3 +151,29 @@ CSHARP_ARRAYS_FIXED(unsigned long long, ulong)
 CSHARP_ARRAYS_FIXED(float, float)
 CSHARP_ARRAYS_FIXED(double, double)
 
+
+%define CSHARP_ARRAYS_SPAN( CTYPE, CSTYPE )
+
+%typemap(ctype)   CTYPE SPAN[], CTYPE READONLYSPAN[] "CTYPE*"
+%typemap(imtype)  CTYPE SPAN[], CTYPE READONLYSPAN[] "ref CSTYPE"
+%typemap(cstype)  CTYPE SPAN[] "System.Span<CSTYPE>"
+%typemap(cstype)  CTYPE READONLYSPAN[] "System.ReadOnlySpan<CSTYPE>"
+%typemap(csin)    CTYPE SPAN[], CTYPE READONLYSPAN[] "ref System.Runtime.InteropServices.MemoryMarshal.GetReference($csinput)"
+
+%typemap(in)      CTYPE SPAN[], CTYPE READONLYSPAN[] "$1 = ($1_ltype)$input;"
+%typemap(freearg) CTYPE SPAN[], CTYPE READONLYSPAN[] ""
+%typemap(argout)  CTYPE SPAN[], CTYPE READONLYSPAN[] ""
+
+%enddef // CSHARP_ARRAYS_SPAN
+
+CSHARP_ARRAYS_SPAN(signed char, sbyte)
+CSHARP_ARRAYS_SPAN(unsigned char, byte)
+CSHARP_ARRAYS_SPAN(short, short)
+CSHARP_ARRAYS_SPAN(unsigned short, ushort)
+CSHARP_ARRAYS_SPAN(int, int)
+CSHARP_ARRAYS_SPAN(unsigned int, uint)
+// No long or unsigned long as the span would be viewed in place and C# int is not the same size as long on all platforms
+CSHARP_ARRAYS_SPAN(long long, long)
+CSHARP_ARRAYS_SPAN(unsigned long long, ulong)
+CSHARP_ARRAYS_SPAN(float, float)
+CSHARP_ARRAYS_SPAN(double, double)
@@ -16,6 +16,12 @@
  *   SWIG_STD_VECTOR_ENHANCED(SomeNamespace::Klass)
  *   %template(VectKlass) std::vector<SomeNamespace::Klass>;
  *
+ * When SWIG_CSHARP_SPAN is defined before including this file (swig -DSWIG_CSHARP_SPAN), vectors of
+ * the fixed size numeric types also have an AsSpan() method returning a System.Span<T> which views
+ * the vector's elements in place, without copying them. Like the unmanaged memory it views, the span
+ * is only valid until the vector is resized or disposed. The generated C# requires .NET Core 2.1 or
+ * later (or the System.Memory package) and must be compiled with -unsafe.
+ *
  * Warning: heavy macro usage in this file. Use swig -E to get a sane view on the real file contents!
  * ----------------------------------------------------------------------------- */
 
@@ -351,6 +357,24 @@
     }
 %enddef
 
+// Extra method added to the collection class for numeric types whose C and C# types are the same size
+// AsSpan() returns a System.Span<> viewing the vector's elements without copying them
+%define SWIG_STD_VECTOR_EXTRA_SPAN(CTYPE...)
+    %typemap(imtype) CTYPE *AsSpan "IntPtr"
+    %typemap(cstype) CTYPE *AsSpan "System.Span<$typemap(cstype, CTYPE)>"
+    %typemap(csout, excode=SWIGEXCODE) CTYPE *AsSpan {
+    IntPtr cPtr = $imcall;$excode
+    unsafe {
+      return new System.Span<$typemap(cstype, CTYPE)>((void *)cPtr, Count);
+    }
+  }
+    %extend {
+      CTYPE *AsSpan() {
+        return $self->empty() ? 0 : &(*$self)[0];
+      }
+    }
+%enddef
+
 // Macros for std::vector class specializations/enhancements
 %define SWIG_STD_VECTOR_ENHANCED(CTYPE...)
 namespace std {
@@ -361,6 +385,22 @@ namespace std {
 }
 %enddef
 
+#if defined(SWIG_CSHARP_SPAN)
+%define SWIG_STD_VECTOR_NUMERIC(CTYPE...)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_MINIMUM_INTERNAL(IList, %arg(CTYPE const&), %arg(CTYPE))
+    SWIG_STD_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE)
+    SWIG_STD_VECTOR_EXTRA_SPAN(CTYPE)
+  };
+}
+%enddef
+#else
+%define SWIG_STD_VECTOR_NUMERIC(CTYPE...)
+SWIG_STD_VECTOR_ENHANCED(CTYPE)
+%enddef
+#endif
+
 // Legacy macros
 %define SWIG_STD_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_STD_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_STD_VECTOR_ENHANCED
@@ -405,17 +445,17 @@ namespace std {
 // template specializations for std::vector
 // these provide extra collections methods as operator== is defined
 SWIG_STD_VECTOR_ENHANCED(char)
-SWIG_STD_VECTOR_ENHANCED(signed char)
-SWIG_STD_VECTOR_ENHANCED(unsigned char)
-SWIG_STD_VECTOR_ENHANCED(short)
-SWIG_STD_VECTOR_ENHANCED(unsigned short)
-SWIG_STD_VECTOR_ENHANCED(int)
-SWIG_STD_VECTOR_ENHANCED(unsigned int)
-SWIG_STD_VECTOR_ENHANCED(long)
+SWIG_STD_VECTOR_NUMERIC(signed char)
+SWIG_STD_VECTOR_NUMERIC(unsigned char)
+SWIG_STD_VECTOR_NUMERIC(short)
+SWIG_STD_VECTOR_NUMERIC(unsigned short)
+SWIG_STD_VECTOR_NUMERIC(int)
+SWIG_STD_VECTOR_NUMERIC(unsigned int)
+SWIG_STD_VECTOR_ENHANCED(long) // C# int is not the same size as long on all platforms
 SWIG_STD_VECTOR_ENHANCED(unsigned long)
-SWIG_STD_VECTOR_ENHANCED(long long)
-SWIG_STD_VECTOR_ENHANCED(unsigned long long)
-SWIG_STD_VECTOR_ENHANCED(float)
-SWIG_STD_VECTOR_ENHANCED(double)
+SWIG_STD_VECTOR_NUMERIC(long long)
+SWIG_STD_VECTOR_NUMERIC(unsigned long long)
+SWIG_STD_VECTOR_NUMERIC(float)
+SWIG_STD_VECTOR_NUMERIC(double)
 SWIG_STD_VECTOR_ENHANCED(std::string) // also requires a %include <std_string.i>
 
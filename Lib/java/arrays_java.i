@@ -4,7 +4,8 @@
  * These typemaps give more natural support for arrays. The typemaps are not efficient
  * as there is a lot of copying of the array values whenever the array is passed to C/C++ 
  * from Java and vice versa. The Java array is expected to be the same size as the C array.
- * An exception is thrown if they are not.
+ * An exception is thrown if they are not. See the CRITICAL and DIRECT typemaps below for
+ * alternatives which do not copy primitive arrays.
  *
  * Example usage:
  * Wrapping:
@@ -228,6 +229,108 @@ JAVA_ARRAYS_TYPEMAPS(double, double, jdouble, Double, "[D")     /* double[ANY] *
     ""
 
 
+/* Zero copy alternatives to the above for primitive types with the same size as the JNI type.
+ * Use %apply to select them for particular parameters.
+ *
+ * CRITICAL: the Java array is accessed in place with GetPrimitiveArrayCritical, rather than
+ * copied in and out. Between the Get and the Release the JVM may hold off garbage collection
+ * and no other JNI calls are allowed, so only use these for short, non-blocking functions
+ * which do not call back into Java. The array is acquired in the check typemap, after all the
+ * in typemaps, and released in the argout typemap, which comes after the out typemap. So the
+ * other parameters must be primitive types (with no check typemaps which may return early)
+ * and the return type must be void or a primitive type, as the out typemaps of other types
+ * call JNI functions.
+ *
+ *   %apply float *CRITICAL { float *samples };
+ *   %apply (float *CRITICAL, size_t LENGTH) { (float *samples, size_t count) };
+ *
+ * DIRECT: the C pointer is the memory of a direct java.nio buffer (GetDirectBufferAddress), so
+ * nothing is copied or pinned. The buffer must be direct (else an IllegalArgumentException is
+ * thrown), its position is ignored and LENGTH is its capacity. Buffers viewing a ByteBuffer,
+ * eg ByteBuffer.allocateDirect(n).order(ByteOrder.nativeOrder()).asFloatBuffer(), must use the
+ * native byte order.
+ *
+ *   %apply (float *DIRECT, size_t LENGTH) { (float *data, size_t n) };
+ */
+%define JAVA_ARRAYS_CRITICAL_TYPEMAPS(CTYPE, JTYPE, JNITYPE, JBUFFER, PRECEDENCE)
+
+%typemap(jni) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JNITYPE##Array%}
+%typemap(jtype) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(jstype) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(javain) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) "$javainput"
+%typemap(freearg) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) ""
+
+%typemap(in) CTYPE *CRITICAL, CTYPE CRITICAL[]
+%{  $1 = 0; %}
+%typemap(in) (CTYPE *CRITICAL, size_t LENGTH)
+%{  $1 = 0;
+  $2 = 0;
+  if ($input) {
+    $2 = ($2_ltype) JCALL1(GetArrayLength, jenv, $input);
+  } %}
+%typemap(check) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH)
+%{  if ($input) {
+    $1 = ($1_ltype) JCALL2(GetPrimitiveArrayCritical, jenv, $input, 0);
+    if (!$1) return $null;
+  } %}
+%typemap(argout) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH)
+%{ if ($input) JCALL3(ReleasePrimitiveArrayCritical, jenv, $input, (void *)$1, 0); %}
+
+%typemap(jni) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) "jobject"
+%typemap(jtype) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) "java.nio.JBUFFER"
+%typemap(jstype) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) "java.nio.JBUFFER"
+%typemap(javain) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) "$javainput"
+%typemap(freearg) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) ""
+
+%typemap(in) CTYPE *DIRECT
+%{  $1 = 0;
+  if ($input) {
+    $1 = ($1_ltype) JCALL1(GetDirectBufferAddress, jenv, $input);
+    if (!$1) {
+      SWIG_JavaThrowException(jenv, SWIG_JavaIllegalArgumentException, "not a direct buffer");
+      return $null;
+    }
+  } %}
+%typemap(in) (CTYPE *DIRECT, size_t LENGTH)
+%{  $1 = 0;
+  $2 = 0;
+  if ($input) {
+    $1 = ($1_ltype) JCALL1(GetDirectBufferAddress, jenv, $input);
+    if (!$1) {
+      SWIG_JavaThrowException(jenv, SWIG_JavaIllegalArgumentException, "not a direct buffer");
+      return $null;
+    }
+    $2 = ($2_ltype) JCALL1(GetDirectBufferCapacity, jenv, $input);
+  } %}
+
+%typecheck(PRECEDENCE) CTYPE *CRITICAL, CTYPE CRITICAL[], (CTYPE *CRITICAL, size_t LENGTH) ""
+%typecheck(SWIG_TYPECHECK_POINTER) CTYPE *DIRECT, (CTYPE *DIRECT, size_t LENGTH) ""
+
+%apply (CTYPE *CRITICAL, size_t LENGTH) { (CTYPE *CRITICAL, int LENGTH) }
+%apply (CTYPE *DIRECT, size_t LENGTH) { (CTYPE *DIRECT, int LENGTH) }
+%enddef
+
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(char, byte, jbyte, ByteBuffer, SWIG_TYPECHECK_INT8_ARRAY)          /* raw bytes */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(signed char, byte, jbyte, ByteBuffer, SWIG_TYPECHECK_INT8_ARRAY)
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(unsigned char, byte, jbyte, ByteBuffer, SWIG_TYPECHECK_INT8_ARRAY) /* raw bytes */
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(short, short, jshort, ShortBuffer, SWIG_TYPECHECK_INT16_ARRAY)
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(int, int, jint, IntBuffer, SWIG_TYPECHECK_INT32_ARRAY)
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(long long, long, jlong, LongBuffer, SWIG_TYPECHECK_INT64_ARRAY)
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(float, float, jfloat, FloatBuffer, SWIG_TYPECHECK_FLOAT_ARRAY)
+JAVA_ARRAYS_CRITICAL_TYPEMAPS(double, double, jdouble, DoubleBuffer, SWIG_TYPECHECK_DOUBLE_ARRAY)
+
+/* Untyped memory in a direct java.nio.ByteBuffer */
+%typemap(jni) void *DIRECT, (void *DIRECT, size_t LENGTH) "jobject"
+%typemap(jtype) void *DIRECT, (void *DIRECT, size_t LENGTH) "java.nio.ByteBuffer"
+%typemap(jstype) void *DIRECT, (void *DIRECT, size_t LENGTH) "java.nio.ByteBuffer"
+%typemap(javain) void *DIRECT, (void *DIRECT, size_t LENGTH) "$javainput"
+%typemap(freearg) void *DIRECT, (void *DIRECT, size_t LENGTH) ""
+%typemap(in) void *DIRECT = char *DIRECT;
+%typemap(in) (void *DIRECT, size_t LENGTH) = (char *DIRECT, size_t LENGTH);
+%typecheck(SWIG_TYPECHECK_POINTER) void *DIRECT, (void *DIRECT, size_t LENGTH) ""
+%apply (void *DIRECT, size_t LENGTH) { (void *DIRECT, int LENGTH) }
+
+
 /* Arrays of proxy classes. The typemaps in this macro make it possible to treat an array of 
  * class/struct/unions as an array of Java classes. 
  * Use the following macro to use these typemaps for an array of class/struct/unions called name:
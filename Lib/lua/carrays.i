@@ -6,3 +6,95 @@ for operator[] access
 %rename(__setitem) *::setitem; // the X[i]=v (set operator)
 
 %include <../carrays.i>
+
+/* -----------------------------------------------------------------------------
+ * %numeric_array_class(TYPE,NAME)
+ *
+ * As %array_class(TYPE,NAME) for numeric TYPEs, plus bulk operations which
+ * copy a whole batch in one call, rather than one __getitem/__setitem per element:
+ *
+ *    a:from_table(t [,start])      -- a[start..] = t[1..#t]
+ *    t=a:to_table(count [,start])  -- t[1..count] = a[start..]
+ *    n=a:copy_from_blob(s,count [,start])
+ *                                  -- copies the raw bytes of the string s into a[start..],
+ *                                  -- at most count elements, and returns the number copied
+ *    s=a:to_blob(count [,start])   -- the raw bytes of a[start..start+count-1] as a string,
+ *                                  -- raises an error if count is negative
+ *    a=NAME_blob(nelements)        -- an array whose (zeroed) memory is the userdata itself,
+ *                                  -- freed by the garbage collector rather than by delete
+ *
+ * Note: as with __getitem/__setitem, there is no bounds checking, so count
+ * must not exceed the space left in the array.
+ * ----------------------------------------------------------------------------- */
+
+%{
+typedef int SWIGLUA_ARRAY_TABLE;  /* stack index of a table argument */
+typedef int SWIGLUA_ARRAY_STRING; /* stack index of a string argument */
+typedef int SWIGLUA_ARRAY_RESULT; /* number of values pushed onto the stack */
+%}
+typedef int SWIGLUA_ARRAY_TABLE;
+typedef int SWIGLUA_ARRAY_STRING;
+typedef int SWIGLUA_ARRAY_RESULT;
+
+%typemap(in,checkfn="lua_istable") SWIGLUA_ARRAY_TABLE
+%{$1 = $input;%}
+%typemap(in,checkfn="lua_isstring") SWIGLUA_ARRAY_STRING
+%{$1 = $input;%}
+%typemap(out) SWIGLUA_ARRAY_RESULT
+%{SWIG_arg += $1;%}
+%typecheck(SWIG_TYPECHECK_POINTER) SWIGLUA_ARRAY_TABLE
+%{$1 = lua_istable(L,$input);%}
+%typecheck(SWIG_TYPECHECK_STRING) SWIGLUA_ARRAY_STRING
+%{$1 = lua_isstring(L,$input);%}
+
+%define %numeric_array_class(TYPE,NAME)
+%array_class(TYPE,NAME)
+
+%feature("compactdefaultargs") NAME::from_table;
+%feature("compactdefaultargs") NAME::to_table;
+%feature("compactdefaultargs") NAME::copy_from_blob;
+%feature("compactdefaultargs") NAME::to_blob;
+
+%extend NAME {
+void from_table(lua_State *L, SWIGLUA_ARRAY_TABLE t, int start = 0) {
+  int i, n = (int)lua_rawlen(L, t);
+  for (i = 0; i < n; i++) {
+    lua_rawgeti(L, t, i + 1);
+    if (!lua_isnumber(L, -1)) {
+      luaL_error(L, "table must contain numbers");
+    }
+    self[start + i] = (TYPE)lua_tonumber(L, -1);
+    lua_pop(L, 1);
+  }
+}
+SWIGLUA_ARRAY_RESULT to_table(lua_State *L, int count, int start = 0) {
+  int i;
+  lua_newtable(L);
+  for (i = 0; i < count; i++) {
+    lua_pushnumber(L, (lua_Number)self[start + i]);
+    lua_rawseti(L, -2, i + 1);
+  }
+  return 1;
+}
+int copy_from_blob(lua_State *L, SWIGLUA_ARRAY_STRING s, int count, int start = 0) {
+  int n = (int)(lua_rawlen(L, s) / sizeof(TYPE));
+  if (n > count)
+    n = count;
+  if (n <= 0)
+    return 0;
+  memcpy(self + start, lua_tostring(L, s), n * sizeof(TYPE));
+  return n;
+}
+SWIGLUA_ARRAY_RESULT to_blob(lua_State *L, int count, int start = 0) {
+  if (count < 0)
+    luaL_error(L, "count must not be negative");
+  lua_pushlstring(L, (const char *)(self + start), count * sizeof(TYPE));
+  return 1;
+}
+static SWIGLUA_ARRAY_RESULT blob(lua_State *L, int nelements) {
+  SWIG_Lua_NewValueObj(L, 0, nelements * sizeof(TYPE), $descriptor(NAME *));
+  return 1;
+}
+};
+
+%enddef
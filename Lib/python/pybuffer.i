@@ -103,5 +103,192 @@
 }
 %enddef
 
+/* The macros below use the buffer protocol introduced in Python 2.6
+ * (PEP 3118) and accept any object exporting a C contiguous buffer,
+ * eg. bytearray, array.array, memoryview or a numpy array.
+ */
+
+%fragment("SWIG_Python_GetContiguousBuffer", "header") {
+/* Get a C contiguous buffer of items of the given size from obj. If
+   format is given the buffer must hold items of that struct format,
+   otherwise any buffer of matching or byte sized items is accepted.
+   On success the buffer must be released with PyBuffer_Release. */
+SWIGINTERN int
+SWIG_Python_GetContiguousBuffer(PyObject *obj, Py_buffer *view, size_t itemsize, const char *format, int writable)
+{
+  const char *fmt;
+  int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+  if (writable)
+    flags |= PyBUF_WRITABLE;
+  if (!PyObject_CheckBuffer(obj))
+    return SWIG_TypeError;
+  if (PyObject_GetBuffer(obj, view, flags) != 0) {
+    PyErr_Clear();
+    return SWIG_TypeError;
+  }
+  fmt = view->format ? view->format : "B";
+  if (*fmt == '@' || *fmt == '=')
+    fmt++;
+  if (view->len % itemsize
+      || (format && ((size_t)view->itemsize != itemsize || strcmp(fmt, format) != 0))
+      || (!format && (size_t)view->itemsize != itemsize && view->itemsize != 1)) {
+    PyBuffer_Release(view);
+    return SWIG_TypeError;
+  }
+  return SWIG_OK;
+}
+}
 
+%fragment("SWIG_Python_BufferFromData", "header") {
+/* Return a memoryview of the given struct format over a single copy of
+   data. Python versions without memoryview.cast get the bytearray. */
+SWIGINTERN PyObject *
+SWIG_Python_BufferFromData(const void *data, size_t size, const char *format)
+{
+  PyObject *bytes = PyByteArray_FromStringAndSize((const char *)data, (Py_ssize_t)size);
+%#if PY_VERSION_HEX >= 0x03030000
+  if (bytes) {
+    PyObject *view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (view && strcmp(format, "B") != 0) {
+      PyObject *cast = PyObject_CallMethod(view, (char *)"cast", (char *)"s", format);
+      Py_DECREF(view);
+      view = cast;
+    }
+    return view;
+  }
+%#endif
+  return bytes;
+}
+}
 
+/* %pybuffer_array(TYPEMAP, SIZE, FORMAT)
+ *
+ * Macro for functions accept a read only array pointer with its number
+ * of elements. The buffer must hold items of the struct module format
+ * FORMAT. The array is not copied, the function works directly on the
+ * memory of the buffer. For example:
+ *
+ *      %pybuffer_array(const double *data, size_t n, "d");
+ *      double sum(const double *data, size_t n) {
+ *        double s = 0;
+ *        for (size_t i=0; i<n; ++i)
+ *          s += data[i];
+ *        return s;
+ *      }
+ */
+
+%define %pybuffer_array(TYPEMAP, SIZE, FORMAT)
+%typemap(in, fragment="SWIG_Python_GetContiguousBuffer") (TYPEMAP, SIZE)
+  (int res, Py_buffer view, int got_view = 0) {
+  res = SWIG_Python_GetContiguousBuffer($input, &view, sizeof($*1_type), FORMAT, 0);
+  if (!SWIG_IsOK(res)) {
+    %argument_fail(res, "(TYPEMAP, SIZE)", $symname, $argnum);
+  }
+  got_view = 1;
+  $1 = ($1_ltype) view.buf;
+  $2 = ($2_ltype) (view.len / sizeof($*1_type));
+}
+%typemap(freearg) (TYPEMAP, SIZE) {
+  if (got_view$argnum) PyBuffer_Release(&view$argnum);
+}
+%enddef
+
+/* %pybuffer_mutable_array(TYPEMAP, SIZE, FORMAT)
+ *
+ * Same as %pybuffer_array, but the buffer must be writable and the
+ * function may modify it in place. For example:
+ *
+ *      %pybuffer_mutable_array(double *data, size_t n, "d");
+ *      void scale(double *data, size_t n, double factor) {
+ *        for (size_t i=0; i<n; ++i)
+ *          data[i] *= factor;
+ *      }
+ */
+
+%define %pybuffer_mutable_array(TYPEMAP, SIZE, FORMAT)
+%typemap(in, fragment="SWIG_Python_GetContiguousBuffer") (TYPEMAP, SIZE)
+  (int res, Py_buffer view, int got_view = 0) {
+  res = SWIG_Python_GetContiguousBuffer($input, &view, sizeof($*1_type), FORMAT, 1);
+  if (!SWIG_IsOK(res)) {
+    %argument_fail(res, "(TYPEMAP, SIZE)", $symname, $argnum);
+  }
+  got_view = 1;
+  $1 = ($1_ltype) view.buf;
+  $2 = ($2_ltype) (view.len / sizeof($*1_type));
+}
+%typemap(freearg) (TYPEMAP, SIZE) {
+  if (got_view$argnum) PyBuffer_Release(&view$argnum);
+}
+%enddef
+
+/* %pybuffer_std_vector(TYPE, FORMAT)
+ *
+ * Macro for functions taking or returning a std::vector of a plain data
+ * type whose struct module format character is FORMAT. A std::vector<TYPE>
+ * or const std::vector<TYPE>& argument is filled from a buffer of FORMAT
+ * items with a single memcpy, other arguments use the usual sequence
+ * conversion. A returned std::vector<TYPE> becomes a memoryview of FORMAT
+ * items instead of a tuple. Use it after std_vector.i has been included
+ * and the vector has been instantiated with %template. For example:
+ *
+ *      %include <std_vector.i>
+ *      %template(DoubleVector) std::vector<double>;
+ *      %pybuffer_std_vector(double, "d");
+ *      std::vector<double> linspace(double a, double b, size_t n);
+ */
+
+%define %pybuffer_std_vector(TYPE, FORMAT)
+%typemap(in, fragment="SWIG_Python_GetContiguousBuffer") std::vector<TYPE> (Py_buffer view) {
+  if (SWIG_IsOK(SWIG_Python_GetContiguousBuffer($input, &view, sizeof(TYPE), FORMAT, 0))) {
+    const TYPE *data = (const TYPE *) view.buf;
+    $1.assign(data, data + view.len / sizeof(TYPE));
+    PyBuffer_Release(&view);
+  } else {
+    std::vector<TYPE > *ptr = 0;
+    int res = swig::asptr($input, &ptr);
+    if (!SWIG_IsOK(res)) {
+      %argument_fail(res, "$type", $symname, $argnum);
+    }
+    if (!ptr) {
+      %argument_fail(SWIG_TypeError, "$type", $symname, $argnum);
+    }
+    $1 = *ptr;
+    if (SWIG_IsNewObj(res)) delete ptr;
+  }
+}
+%typemap(in, fragment="SWIG_Python_GetContiguousBuffer") const std::vector<TYPE> & (int res = SWIG_OLDOBJ, Py_buffer view) {
+  if (SWIG_IsOK(SWIG_Python_GetContiguousBuffer($input, &view, sizeof(TYPE), FORMAT, 0))) {
+    const TYPE *data = (const TYPE *) view.buf;
+    $1 = new std::vector<TYPE >(data, data + view.len / sizeof(TYPE));
+    res = SWIG_NEWOBJ;
+    PyBuffer_Release(&view);
+  } else {
+    std::vector<TYPE > *ptr = 0;
+    res = swig::asptr($input, &ptr);
+    if (!SWIG_IsOK(res)) {
+      %argument_fail(res, "$type", $symname, $argnum);
+    }
+    if (!ptr) {
+      %argument_nullref("$type", $symname, $argnum);
+    }
+    $1 = ptr;
+  }
+}
+%typemap(freearg) const std::vector<TYPE> & {
+  if (SWIG_IsNewObj(res$argnum)) delete $1;
+}
+%typemap(typecheck, precedence=SWIG_TYPECHECK_VECTOR, fragment="SWIG_Python_GetContiguousBuffer")
+  std::vector<TYPE>, const std::vector<TYPE> & {
+  Py_buffer view;
+  if (SWIG_IsOK(SWIG_Python_GetContiguousBuffer($input, &view, sizeof(TYPE), FORMAT, 0))) {
+    PyBuffer_Release(&view);
+    $1 = 1;
+  } else {
+    $1 = SWIG_CheckState(swig::asptr($input, (std::vector<TYPE > **)0));
+  }
+}
+%typemap(out, fragment="SWIG_Python_BufferFromData") std::vector<TYPE> {
+  $result = SWIG_Python_BufferFromData($1.empty() ? 0 : &$1[0], $1.size() * sizeof(TYPE), FORMAT);
+}
+%enddef
@@ -0,0 +1,124 @@
+/* -----------------------------------------------------------------------------
+ * carrays.i
+ *
+ * The standard carrays.i, plus %numeric_array_class(TYPE,NAME) which adds
+ * bulk operations to %array_class(TYPE,NAME) for numeric TYPEs, copying a
+ * whole batch in one call rather than one getitem/setitem per element:
+ *
+ *    n = a.from_table(arr [,start])    a[start..] = arr[0..arr.len()-1]
+ *                                      stops at the first non number, returns
+ *                                      the number of elements copied
+ *    arr = a.to_table(count [,start])  an array of a[start..start+count-1]
+ *    n = a.copy_from_blob(b, count [,start])
+ *                                      copies the bytes of the blob b into a[start..],
+ *                                      at most count elements, returns the number copied
+ *    b = a.to_blob(count [,start])     a new blob holding a[start..start+count-1],
+ *                                      raises an error if count is negative
+ *    p = NAME.map_blob(b)              a NAME* pointing at the memory of the blob b
+ *                                      (which must be kept alive while p is used)
+ *
+ * Note: as with getitem/setitem, there is no bounds checking, so count
+ * must not exceed the space left in the array.
+ * ----------------------------------------------------------------------------- */
+
+%include <../carrays.i>
+
+%{
+#include <sqstdblob.h>
+
+typedef SQInteger SWIGSQ_ARRAY_ARRAY;  /* stack index of an array argument */
+typedef SQInteger SWIGSQ_ARRAY_BLOB;   /* stack index of a blob argument */
+typedef SQInteger SWIGSQ_ARRAY_RESULT; /* the result has been pushed onto the stack */
+
+static int is_blob(HSQUIRRELVM v, int index)
+{
+  SQUserPointer p;
+  return SQ_SUCCEEDED(sqstd_getblob(v, index, &p));
+}
+%}
+typedef SQInteger SWIGSQ_ARRAY_ARRAY;
+typedef SQInteger SWIGSQ_ARRAY_BLOB;
+typedef SQInteger SWIGSQ_ARRAY_RESULT;
+
+%typemap(in, checkfn="is_array") SWIGSQ_ARRAY_ARRAY
+%{$1 = $input;%}
+%typemap(in, checkfn="is_blob") SWIGSQ_ARRAY_BLOB
+%{$1 = $input;%}
+%typemap(out) SWIGSQ_ARRAY_RESULT "if (SQ_FAILED($1)) SWIG_fail;";
+
+%define %numeric_array_class(TYPE,NAME)
+%array_class(TYPE,NAME)
+
+%feature("compactdefaultargs") NAME::from_table;
+%feature("compactdefaultargs") NAME::to_table;
+%feature("compactdefaultargs") NAME::copy_from_blob;
+%feature("compactdefaultargs") NAME::to_blob;
+
+%extend NAME {
+int from_table(HSQUIRRELVM v, SWIGSQ_ARRAY_ARRAY arr, int start = 0) {
+  SQInteger i, n = sq_getsize(v, arr);
+  SQInteger ival;
+  SQFloat fval;
+  for (i = 0; i < n; i++) {
+    sq_pushinteger(v, i);
+    if (SQ_FAILED(sq_get(v, arr)))
+      break;
+    if ((TYPE)0.5 != 0) {
+      if (SQ_FAILED(sq_getfloat(v, -1, &fval))) {
+        sq_pop(v, 1);
+        break;
+      }
+      self[start + i] = (TYPE)fval;
+    } else {
+      if (SQ_FAILED(sq_getinteger(v, -1, &ival))) {
+        sq_pop(v, 1);
+        break;
+      }
+      self[start + i] = (TYPE)ival;
+    }
+    sq_pop(v, 1);
+  }
+  return (int)i;
+}
+SWIGSQ_ARRAY_RESULT to_table(HSQUIRRELVM v, int count, int start = 0) {
+  int i;
+  sq_newarray(v, 0);
+  for (i = 0; i < count; i++) {
+    if ((TYPE)0.5 != 0)
+      sq_pushfloat(v, (SQFloat)self[start + i]);
+    else
+      sq_pushinteger(v, (SQInteger)self[start + i]);
+    sq_arrayappend(v, -2);
+  }
+  return 1;
+}
+int copy_from_blob(HSQUIRRELVM v, SWIGSQ_ARRAY_BLOB b, int count, int start = 0) {
+  SQUserPointer data;
+  int n;
+  sqstd_getblob(v, b, &data);
+  n = (int)(sqstd_getblobsize(v, b) / sizeof(TYPE));
+  if (n > count)
+    n = count;
+  if (n <= 0)
+    return 0;
+  memcpy(self + start, data, n * sizeof(TYPE));
+  return n;
+}
+SWIGSQ_ARRAY_RESULT to_blob(HSQUIRRELVM v, int count, int start = 0) {
+  SQUserPointer data;
+  if (count < 0)
+    return sq_throwerror(v, _SC("count must not be negative"));
+  data = sqstd_createblob(v, count * sizeof(TYPE));
+  if (!data)
+    return sq_throwerror(v, _SC("cannot create the blob"));
+  memcpy(data, self + start, count * sizeof(TYPE));
+  return 1;
+}
+static NAME *map_blob(HSQUIRRELVM v, SWIGSQ_ARRAY_BLOB b) {
+  SQUserPointer data;
+  sqstd_getblob(v, b, &data);
+  return (NAME *)data;
+}
+};
+
+%enddef
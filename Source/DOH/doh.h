@@ -94,6 +94,7 @@
 #define DohNewString       DOH_NAMESPACE(NewString)
 #define DohNewStringEmpty  DOH_NAMESPACE(NewStringEmpty)
 #define DohNewStringWithSize  DOH_NAMESPACE(NewStringWithSize)
+#define DohNewStringAdopt  DOH_NAMESPACE(NewStringAdopt)
 #define DohNewStringf      DOH_NAMESPACE(NewStringf)
 #define DohStrcmp          DOH_NAMESPACE(Strcmp)
 #define DohStrncmp         DOH_NAMESPACE(Strncmp)
@@ -279,6 +280,7 @@ extern int DohGetmark(DOH *obj);
 extern DOHString *DohNewStringEmpty(void);
 extern DOHString *DohNewString(const DOHString_or_char *c);
 extern DOHString *DohNewStringWithSize(const DOHString_or_char *c, int len);
+extern DOHString *DohNewStringAdopt(char *s, int len);
 extern DOHString *DohNewStringf(const DOHString_or_char *fmt, ...);
 
 extern int DohStrcmp(const DOHString_or_char *s1, const DOHString_or_char *s2);
@@ -411,6 +413,7 @@ extern void DohMemoryDebug(void);
 #define NewString          DohNewString
 #define NewStringEmpty     DohNewStringEmpty
 #define NewStringWithSize  DohNewStringWithSize
+#define NewStringAdopt     DohNewStringAdopt
 #define NewStringf         DohNewStringf
 #define NewHash            DohNewHash
 #define NewList            DohNewList
@@ -128,5 +128,8 @@ typedef struct {
 
 extern DOH *DohObjMalloc(DohObjInfo *type, void *data);	/* Allocate a DOH object */
 extern void DohObjFree(DOH *ptr);	/* Free a DOH object     */
+extern void *DohArenaMalloc(size_t size);	/* Allocate a small payload */
+extern void DohArenaFree(void *ptr, size_t size);	/* Free a small payload */
+extern void DohHashChainStats(DOH *ho, int *nitems, int *nbuckets, int *nused, int *maxchain);	/* Hash collision statistics */
 
 #endif				/* DOHINT_H */
@@ -34,58 +34,87 @@ typedef struct Hash {
 /* Key interning structure */
 typedef struct KeyValue {
   char *cstr;
+  unsigned int hv;
   DOH *sstr;
-  struct KeyValue *left;
-  struct KeyValue *right;
 } KeyValue;
 
-static KeyValue *root = 0;
+static KeyValue *key_table = 0;
+static int key_tablesize = 0;
+static int key_nitems = 0;
 static int max_expand = 1;
 
+#define KEY_TABLE_INIT_SIZE 1024
+
+/* Hash a C string for the interned key table (FNV-1a) */
+static unsigned int key_hash(const char *c) {
+  unsigned int h = 2166136261U;
+  while (*c) {
+    h ^= (unsigned char) *(c++);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/* Grow the interned key table, re-placing every entry.  The table size is
+   always a power of two so that probing can use a mask instead of a modulus. */
+static void key_table_resize(int newsize) {
+  KeyValue *table = (KeyValue *) DohMalloc(newsize * sizeof(KeyValue));
+  int i;
+  memset(table, 0, newsize * sizeof(KeyValue));
+  for (i = 0; i < key_tablesize; i++) {
+    KeyValue *kv = &key_table[i];
+    if (kv->cstr) {
+      unsigned int j = kv->hv & (newsize - 1);
+      while (table[j].cstr)
+	j = (j + 1) & (newsize - 1);
+      table[j] = *kv;
+    }
+  }
+  DohFree(key_table);
+  key_table = table;
+  key_tablesize = newsize;
+}
+
 /* Find or create a key in the interned key table */
 static DOH *find_key(DOH *doh_c) {
   char *c = (char *) doh_c;
-  KeyValue *r, *s;
-  int d = 0;
-  /* OK, sure, we use a binary tree for maintaining interned
-     symbols.  Then we use their hash values for accessing secondary
-     hash tables. */
-  r = root;
-  s = 0;
-  while (r) {
-    s = r;
-    d = strcmp(r->cstr, c);
-    if (d == 0)
-      return r->sstr;
-    if (d < 0)
-      r = r->left;
-    else
-      r = r->right;
+  unsigned int hv = key_hash(c);
+  unsigned int i;
+  KeyValue *kv;
+  DOH *sstr;
+
+  /* Interned symbols live in an open-addressed table with linear probing.
+     The full hash of each symbol is kept so that string comparisons are only
+     done on a likely match.  The interned String's own hash value is then
+     used for accessing secondary hash tables. */
+  if (!key_table)
+    key_table_resize(KEY_TABLE_INIT_SIZE);
+  i = hv & (key_tablesize - 1);
+  while ((kv = &key_table[i])->cstr) {
+    if (kv->hv == hv && strcmp(kv->cstr, c) == 0)
+      return kv->sstr;
+    i = (i + 1) & (key_tablesize - 1);
   }
   /*  fprintf(stderr,"Interning '%s'\n", c); */
-  r = (KeyValue *) DohMalloc(sizeof(KeyValue));
-  r->cstr = (char *) DohMalloc(strlen(c) + 1);
-  strcpy(r->cstr, c);
-  r->sstr = NewString(c);
-  DohIntern(r->sstr);
-  r->left = 0;
-  r->right = 0;
-  if (!s) {
-    root = r;
-  } else {
-    if (d < 0)
-      s->left = r;
-    else
-      s->right = r;
-  }
-  return r->sstr;
+  kv->cstr = (char *) DohMalloc(strlen(c) + 1);
+  strcpy(kv->cstr, c);
+  kv->hv = hv;
+  sstr = NewString(c);
+  DohIntern(sstr);
+  Hashval(sstr);		/* Cache the hash value in the interned key */
+  kv->sstr = sstr;
+  key_nitems++;
+  if (2 * key_nitems > key_tablesize)
+    key_table_resize(2 * key_tablesize);
+  return sstr;
 }
 
 #define HASH_INIT_SIZE   7
+#define HASH_MAX_LOAD    1	/* Maximum average chain length before growing the table */
 
 /* Create a new hash node */
 static HashNode *NewNode(DOH *k, void *obj) {
-  HashNode *hn = (HashNode *) DohMalloc(sizeof(HashNode));
+  HashNode *hn = (HashNode *) DohArenaMalloc(sizeof(HashNode));
   hn->key = k;
   Incref(hn->key);
   hn->object = obj;
@@ -98,7 +127,7 @@ static HashNode *NewNode(DOH *k, void *obj) {
 static void DelNode(HashNode *hn) {
   Delete(hn->key);
   Delete(hn->object);
-  DohFree(hn);
+  DohArenaFree(hn, sizeof(HashNode));
 }
 
 /* -----------------------------------------------------------------------------
@@ -123,7 +152,7 @@ static void DelHash(DOH *ho) {
   DohFree(h->hashtable);
   h->hashtable = 0;
   h->hashsize = 0;
-  DohFree(h);
+  DohArenaFree(h, sizeof(Hash));
 }
 
 /* -----------------------------------------------------------------------------
@@ -155,7 +184,7 @@ static void resize(Hash *h) {
   int oldsize, newsize;
   int i, p, hv;
 
-  if (h->nitems < 2 * h->hashsize)
+  if (h->nitems < HASH_MAX_LOAD * h->hashsize)
     return;
 
   /* Too big. We have to rescale everything now */
@@ -254,28 +283,29 @@ typedef int (*binop) (DOH *obj1, DOH *obj2);
 
 
 static DOH *Hash_getattr(DOH *h, DOH *k) {
-  DOH *obj = 0;
   Hash *ho = (Hash *) ObjData(h);
   DOH *ko = DohCheck(k) ? k : find_key(k);
   int hv = Hashval(ko) % ho->hashsize;
   DohObjInfo *k_type = ((DohBase*)ko)->type;
   HashNode *n = ho->hashtable[hv];
+  /* Keys are unique within a table, so stop at the first match */
   if (k_type->doh_equal) {
     binop equal = k_type->doh_equal;
     while (n) {
       DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && equal(ko, nk)) obj = n->object;
+      if (nk == (DohBase *)ko) return n->object; /* interned keys match by pointer */
+      if ((k_type == nk->type) && equal(ko, nk)) return n->object;
       n = n->next;
     }
   } else {
     binop cmp = k_type->doh_cmp;
     while (n) {
       DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && (cmp(ko, nk) == 0)) obj = n->object;
+      if ((k_type == nk->type) && (cmp(ko, nk) == 0)) return n->object;
       n = n->next;
     }
   }
-  return obj;
+  return 0;
 }
 
 /* -----------------------------------------------------------------------------
@@ -397,6 +427,31 @@ int DohGetMaxHashExpand(void) {
   return max_expand;
 }
 
+/* -----------------------------------------------------------------------------
+ * DohHashChainStats()
+ *
+ * Accumulates bucket usage and chain length statistics for a hash table.
+ * Used by DohMemoryDebug() to report on collisions.
+ * ----------------------------------------------------------------------------- */
+
+void DohHashChainStats(DOH *ho, int *nitems, int *nbuckets, int *nused, int *maxchain) {
+  Hash *h = (Hash *) ObjData(ho);
+  HashNode *n;
+  int i;
+
+  *nitems += h->nitems;
+  *nbuckets += h->hashsize;
+  for (i = 0; i < h->hashsize; i++) {
+    int chain = 0;
+    for (n = h->hashtable[i]; n; n = n->next)
+      chain++;
+    if (chain)
+      (*nused)++;
+    if (chain > *maxchain)
+      *maxchain = chain;
+  }
+}
+
 /* -----------------------------------------------------------------------------
  * Hash_str()
  *
@@ -473,7 +528,7 @@ static DOH *CopyHash(DOH *ho) {
 
   int i;
   h = (Hash *) ObjData(ho);
-  nh = (Hash *) DohMalloc(sizeof(Hash));
+  nh = (Hash *) DohArenaMalloc(sizeof(Hash));
   nh->hashsize = h->hashsize;
   nh->hashtable = (HashNode **) DohMalloc(nh->hashsize * sizeof(HashNode *));
   for (i = 0; i < nh->hashsize; i++) {
@@ -573,7 +628,7 @@ DohObjInfo DohHashType = {
 DOH *DohNewHash(void) {
   Hash *h;
   int i;
-  h = (Hash *) DohMalloc(sizeof(Hash));
+  h = (Hash *) DohArenaMalloc(sizeof(Hash));
   h->hashsize = HASH_INIT_SIZE;
   h->hashtable = (HashNode **) DohMalloc(h->hashsize * sizeof(HashNode *));
   for (i = 0; i < h->hashsize; i++) {
@@ -40,7 +40,7 @@ static DOH *CopyList(DOH *lo) {
   List *l, *nl;
   int i;
   l = (List *) ObjData(lo);
-  nl = (List *) DohMalloc(sizeof(List));
+  nl = (List *) DohArenaMalloc(sizeof(List));
   nl->nitems = l->nitems;
   nl->maxitems = l->maxitems;
   nl->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
@@ -67,7 +67,7 @@ static void DelList(DOH *lo) {
   for (i = 0; i < l->nitems; i++)
     Delete(l->items[i]);
   DohFree(l->items);
-  DohFree(l);
+  DohArenaFree(l, sizeof(List));
 }
 
 /* -----------------------------------------------------------------------------
@@ -348,7 +348,7 @@ DohObjInfo DohListType = {
 DOH *DohNewList(void) {
   List *l;
   int i;
-  l = (List *) DohMalloc(sizeof(List));
+  l = (List *) DohArenaMalloc(sizeof(List));
   l->nitems = 0;
   l->maxitems = MAXLISTITEMS;
   l->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
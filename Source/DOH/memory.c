@@ -23,10 +23,22 @@
 #define DOH_DEBUG_MEMORY_POOLS
 */
 
+#ifndef DOH_ARENA_CHUNK_SIZE
+#define DOH_ARENA_CHUNK_SIZE  65536
+#endif
+
+#define DOH_CHUNK_BATCH       8	/* Pool chunks obtained per allocation */
+#define DOH_ARENA_GRAIN       8	/* Size class granularity of the payload arena */
+#define DOH_ARENA_MAX         128	/* Largest payload served by the arena */
+
 static int PoolSize = DOH_POOL_SIZE;
 
 DOH *DohNone = 0;		/* The DOH None object */
 
+/* Each pool lives in a chunk aligned on ChunkSize and the Pool structure is
+   the chunk header.  The object header for any DOH pointer can therefore be
+   found by masking the pointer, and a small open-addressed table of chunk
+   addresses tells whether an arbitrary pointer is a DOH object. */
 typedef struct pool {
   DohBase *ptr;			/* Start of pool */
   int len;			/* Length of pool */
@@ -41,24 +53,101 @@ static DohBase *FreeList = 0;	/* List of free objects */
 static Pool *Pools = 0;
 static int pools_initialized = 0;
 
+static size_t ChunkSize = 0;	/* Size and alignment of a pool chunk */
+static char *ChunkReserve = 0;	/* Aligned chunks not yet used by a pool */
+static int ChunkReserveLeft = 0;
+static Pool **ChunkTable = 0;	/* Open-addressed table of pool chunks */
+static int ChunkTableSize = 0;
+static int NumChunks = 0;
+
+/* Size-classed arena for small fixed-size payloads (String, List, Hash and
+   hash node structures).  Freed blocks are kept on a free list per size class. */
+static void *ArenaFreeList[DOH_ARENA_MAX / DOH_ARENA_GRAIN + 1];
+static char *ArenaCurrent = 0;
+static char *ArenaEnd = 0;
+static int ArenaChunks = 0;
+
+/* ----------------------------------------------------------------------
+ * ChunkIndex() - Starting slot for a chunk in the chunk table
+ * ---------------------------------------------------------------------- */
+
+static int ChunkIndex(size_t base, int tablesize) {
+  return (int) (((base / ChunkSize) * 2654435761U) & (unsigned int) (tablesize - 1));
+}
+
+/* ----------------------------------------------------------------------
+ * ChunkRegister() - Add a pool chunk to the chunk table
+ * ---------------------------------------------------------------------- */
+
+static void ChunkRegister(Pool *p) {
+  int i;
+  if (2 * (NumChunks + 1) > ChunkTableSize) {
+    Pool **table;
+    int newsize = ChunkTableSize ? 2 * ChunkTableSize : 64;
+    table = (Pool **) DohMalloc(newsize * sizeof(Pool *));
+    assert(table);
+    memset(table, 0, newsize * sizeof(Pool *));
+    for (i = 0; i < ChunkTableSize; i++) {
+      if (ChunkTable[i]) {
+	int j = ChunkIndex((size_t) ChunkTable[i], newsize);
+	while (table[j])
+	  j = (j + 1) & (newsize - 1);
+	table[j] = ChunkTable[i];
+      }
+    }
+    DohFree(ChunkTable);
+    ChunkTable = table;
+    ChunkTableSize = newsize;
+  }
+  i = ChunkIndex((size_t) p, ChunkTableSize);
+  while (ChunkTable[i])
+    i = (i + 1) & (ChunkTableSize - 1);
+  ChunkTable[i] = p;
+  NumChunks++;
+}
+
+/* ----------------------------------------------------------------------
+ * NewChunk() - Return a new chunk aligned on ChunkSize
+ * ---------------------------------------------------------------------- */
+
+static char *NewChunk() {
+  char *c;
+  if (!ChunkReserveLeft) {
+    /* Allocate a batch of chunks at once so the alignment slack is small */
+    char *raw = (char *) DohMalloc(ChunkSize * (DOH_CHUNK_BATCH + 1));
+    assert(raw);
+    ChunkReserve = (char *) (((size_t) raw + ChunkSize - 1) & ~(ChunkSize - 1));
+    ChunkReserveLeft = DOH_CHUNK_BATCH;
+  }
+  c = ChunkReserve;
+  ChunkReserve += ChunkSize;
+  ChunkReserveLeft--;
+  return c;
+}
+
 /* ----------------------------------------------------------------------
  * CreatePool() - Create a new memory pool 
  * ---------------------------------------------------------------------- */
 
 static void CreatePool() {
   Pool *p = 0;
-  p = (Pool *) DohMalloc(sizeof(Pool));
-  assert(p);
-  p->ptr = (DohBase *) DohMalloc(sizeof(DohBase) * PoolSize);
-  assert(p->ptr);
-  memset(p->ptr, 0, sizeof(DohBase) * PoolSize);
-  p->len = PoolSize;
-  p->blen = PoolSize * sizeof(DohBase);
+  if (!ChunkSize) {
+    /* Smallest power of two holding PoolSize objects, the header takes the place of one object */
+    ChunkSize = 1024;
+    while (ChunkSize < PoolSize * sizeof(DohBase))
+      ChunkSize <<= 1;
+  }
+  p = (Pool *) NewChunk();
+  p->ptr = (DohBase *) ((char *) p + sizeof(Pool));
+  p->len = (int) ((ChunkSize - sizeof(Pool)) / sizeof(DohBase));
+  p->blen = p->len * sizeof(DohBase);
+  memset(p->ptr, 0, p->blen);
   p->current = 0;
   p->pbeg = ((char *) p->ptr);
   p->pend = p->pbeg + p->blen;
   p->next = Pools;
   Pools = p;
+  ChunkRegister(p);
 }
 
 /* ----------------------------------------------------------------------
@@ -81,25 +170,84 @@ static void InitPools() {
  * ---------------------------------------------------------------------- */
 
 int DohCheck(const DOH *ptr) {
-  register Pool *p = Pools;
   register char *cptr = (char *) ptr;
-  while (p) {
-    if ((cptr >= p->pbeg) && (cptr < p->pend)) {
+  register Pool *p;
+  register int i;
+  if (!ChunkTableSize)
+    return 0;
+  p = (Pool *) ((size_t) cptr & ~(ChunkSize - 1));
+  i = ChunkIndex((size_t) p, ChunkTableSize);
+  while (ChunkTable[i]) {
+    if (ChunkTable[i] == p) {
+      if ((cptr >= p->pbeg) && (cptr < p->pend)) {
 #ifdef DOH_DEBUG_MEMORY_POOLS
-      DohBase *b = (DohBase *) ptr;
-      int DOH_object_already_deleted = b->type == 0;
-      assert(!DOH_object_already_deleted);
+	DohBase *b = (DohBase *) ptr;
+	int DOH_object_already_deleted = b->type == 0;
+	assert(!DOH_object_already_deleted);
 #endif
-      return 1;
+	return 1;
+      }
+      return 0;
     }
-    /*
-       pptr = (char *) p->ptr;
-       if ((cptr >= pptr) && (cptr < (pptr+(p->current*sizeof(DohBase))))) return 1; */
-    p = p->next;
+    i = (i + 1) & (ChunkTableSize - 1);
   }
   return 0;
 }
 
+/* ----------------------------------------------------------------------
+ * DohArenaMalloc()
+ *
+ * Allocate a small fixed-size payload.  Blocks are grouped in size classes
+ * of DOH_ARENA_GRAIN bytes and carved out of DOH_ARENA_CHUNK_SIZE chunks.
+ * Larger requests go straight to DohMalloc.
+ * ---------------------------------------------------------------------- */
+
+void *DohArenaMalloc(size_t size) {
+  size_t c = (size + DOH_ARENA_GRAIN - 1) / DOH_ARENA_GRAIN;
+  void *r;
+  if (size > DOH_ARENA_MAX)
+    return DohMalloc(size);
+  if (c == 0)
+    c = 1;
+  r = ArenaFreeList[c];
+  if (r) {
+    ArenaFreeList[c] = *((void **) r);
+    return r;
+  }
+  size = c * DOH_ARENA_GRAIN;
+  if (!ArenaCurrent || size > (size_t) (ArenaEnd - ArenaCurrent)) {
+    ArenaCurrent = (char *) DohMalloc(DOH_ARENA_CHUNK_SIZE);
+    assert(ArenaCurrent);
+    ArenaEnd = ArenaCurrent + DOH_ARENA_CHUNK_SIZE;
+    ArenaChunks++;
+  }
+  r = ArenaCurrent;
+  ArenaCurrent += size;
+  return r;
+}
+
+/* ----------------------------------------------------------------------
+ * DohArenaFree()
+ *
+ * Return a payload obtained from DohArenaMalloc() with the same size.
+ * ---------------------------------------------------------------------- */
+
+void DohArenaFree(void *ptr, size_t size) {
+  size_t c = (size + DOH_ARENA_GRAIN - 1) / DOH_ARENA_GRAIN;
+  if (!ptr)
+    return;
+  if (size > DOH_ARENA_MAX) {
+    DohFree(ptr);
+    return;
+  }
+  if (c == 0)
+    c = 1;
+#ifndef DOH_DEBUG_MEMORY_POOLS
+  *((void **) ptr) = ArenaFreeList[c];
+  ArenaFreeList[c] = ptr;
+#endif
+}
+
 /* -----------------------------------------------------------------------------
  * DohIntern()
  * ----------------------------------------------------------------------------- */
@@ -184,6 +332,11 @@ void DohMemoryDebug(void) {
   int numlist = 0;
   int numhash = 0;
 
+  int hashitems = 0;
+  int hashbuckets = 0;
+  int hashused = 0;
+  int hashmaxchain = 0;
+
   printf("Memory statistics:\n\n");
   printf("Pools:\n");
 
@@ -201,8 +354,10 @@ void DohMemoryDebug(void) {
 	  numstring++;
 	else if (p->ptr[i].type == &DohListType)
 	  numlist++;
-	else if (p->ptr[i].type == &DohHashType)
+	else if (p->ptr[i].type == &DohHashType) {
 	  numhash++;
+	  DohHashChainStats(p->ptr + i, &hashitems, &hashbuckets, &hashused, &hashmaxchain);
+	}
       }
     }
     printf("    Pool %8p: size = %10d. used = %10d. free = %10d\n", (void *) p, p->len, nused, nfree);
@@ -213,11 +368,19 @@ void DohMemoryDebug(void) {
   }
   printf("\n    Total:          size = %10d, used = %10d, free = %10d\n", totsize, totused, totfree);
 
+  printf("\nArena\n");
+  printf("    Chunks    : %d (%d bytes each)\n", ArenaChunks, DOH_ARENA_CHUNK_SIZE);
   printf("\nObject types\n");
   printf("    Strings   : %d\n", numstring);
   printf("    Lists     : %d\n", numlist);
   printf("    Hashes    : %d\n", numhash);
 
+  printf("\nHash chains\n");
+  printf("    Items     : %d\n", hashitems);
+  printf("    Buckets   : %d (%d used)\n", hashbuckets, hashused);
+  printf("    Avg chain : %.2f\n", hashused ? (double) hashitems / hashused : 0.0);
+  printf("    Max chain : %d\n", hashmaxchain);
+
 #if 0
   p = Pools;
   while (p) {
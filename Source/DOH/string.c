@@ -66,7 +66,7 @@ static int String_dump(DOH *so, DOH *out) {
 static DOH *CopyString(DOH *so) {
   String *str;
   String *s = (String *) ObjData(so);
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohArenaMalloc(sizeof(String));
   str->hashkey = s->hashkey;
   str->sp = s->sp;
   str->line = s->line;
@@ -89,7 +89,7 @@ static DOH *CopyString(DOH *so) {
 static void DelString(DOH *so) {
   String *s = (String *) ObjData(so);
   DohFree(s->str);
-  DohFree(s);
+  DohArenaFree(s, sizeof(String));
 }
 
 /* -----------------------------------------------------------------------------
@@ -175,28 +175,53 @@ static int String_equal(DOH *so1, DOH *so2) {
  * String_hash() - Compute string hash value
  * ----------------------------------------------------------------------------- */
 
+#define HASH_ROTL(x, r) (((x) << (r)) | ((x) >> (32 - (r))))
+
 static int String_hash(DOH *so) {
   String *s = (String *) ObjData(so);
   if (s->hashkey >= 0) {
     return s->hashkey;
   } else {
-    register char *c = s->str;
-    register int len = s->len > 50 ? 50 : s->len;
-    register int h = 0;
-    register int mlen = len >> 2;
-    register int i = mlen;
-    for (; i; --i) {
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
+    /* MurmurHash3 (x86_32) over the whole string.  Type strings such as
+       "p.q(const).std::map<(...)>" share long prefixes, so every character
+       takes part and the result is run through a final avalanche step. */
+    register const unsigned char *c = (const unsigned char *) s->str;
+    register int len = s->len;
+    register unsigned int h = 0;
+    register unsigned int k;
+    register int i;
+    for (i = len >> 2; i; --i, c += 4) {
+      k = (unsigned int) c[0] | ((unsigned int) c[1] << 8) | ((unsigned int) c[2] << 16) | ((unsigned int) c[3] << 24);
+      k *= 0xcc9e2d51U;
+      k = HASH_ROTL(k, 15);
+      k *= 0x1b873593U;
+      h ^= k;
+      h = HASH_ROTL(h, 13);
+      h = h * 5 + 0xe6546b64U;
     }
-    for (i = len - (mlen << 2); i; --i) {
-      h = (h << 5) + *(c++);
+    k = 0;
+    switch (len & 3) {
+    case 3:
+      k ^= (unsigned int) c[2] << 16;
+      /* FALLTHRU */
+    case 2:
+      k ^= (unsigned int) c[1] << 8;
+      /* FALLTHRU */
+    case 1:
+      k ^= (unsigned int) c[0];
+      k *= 0xcc9e2d51U;
+      k = HASH_ROTL(k, 15);
+      k *= 0x1b873593U;
+      h ^= k;
     }
-    h &= 0x7fffffff;
-    s->hashkey = h;
-    return h;
+    h ^= (unsigned int) len;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    s->hashkey = (int) (h & 0x7fffffff);
+    return s->hashkey;
   }
 }
 
@@ -1043,7 +1068,7 @@ DOHString *DohNewString(const DOHString_or_char *so) {
     l = s ? (int) strlen(s) : 0;
   }
 
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohArenaMalloc(sizeof(String));
   str->hashkey = hashkey;
   str->sp = 0;
   str->line = 1;
@@ -1073,8 +1098,8 @@ DOHString *DohNewString(const DOHString_or_char *so) {
 
 DOHString *DohNewStringEmpty(void) {
   int max = INIT_MAXSIZE;
-  String *str = (String *) DohMalloc(sizeof(String));
-  str->hashkey = 0;
+  String *str = (String *) DohArenaMalloc(sizeof(String));
+  str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
   str->file = 0;
@@ -1099,7 +1124,7 @@ DOHString *DohNewStringWithSize(const DOHString_or_char *so, int len) {
     s = (char *) so;
   }
 
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohArenaMalloc(sizeof(String));
   str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
@@ -1123,6 +1148,26 @@ DOHString *DohNewStringWithSize(const DOHString_or_char *so, int len) {
   return DohObjMalloc(&DohStringType, str);
 }
 
+/* -----------------------------------------------------------------------------
+ * NewStringAdopt() - Create a new string which takes ownership of s
+ *
+ * s must have been allocated with DohMalloc() and have room for at least
+ * len + 1 characters.  It is freed when the string is deleted.
+ * ----------------------------------------------------------------------------- */
+
+DOHString *DohNewStringAdopt(char *s, int len) {
+  String *str = (String *) DohArenaMalloc(sizeof(String));
+  str->hashkey = -1;
+  str->sp = 0;
+  str->line = 1;
+  str->file = 0;
+  str->str = s;
+  str->maxsize = len + 1;
+  str->str[len] = 0;
+  str->len = len;
+  return DohObjMalloc(&DohStringType, str);
+}
+
 /* -----------------------------------------------------------------------------
  * NewStringf()
  *
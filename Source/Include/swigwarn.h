@@ -264,6 +264,7 @@
 #define WARN_CSHARP_EXCODE                    844
 #define WARN_CSHARP_CANTHROW                  845
 #define WARN_CSHARP_NO_DIRECTORCONNECT_ATTR   846
+#define WARN_CSHARP_SUPPRESSGCTRANSITION      847
 
 /* please leave 830-849 free for C# */
 
@@ -288,6 +289,7 @@
 /* please leave 870-889 free for PHP */
 
 #define WARN_GO_NAME_CONFLICT                 890
+#define WARN_GO_FEATURE_IGNORED               891
 
 /* please leave 890-899 free for Go */
 
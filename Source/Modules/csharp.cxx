@@ -707,6 +707,8 @@ public:
     String *im_outattributes = 0;
     int num_arguments = 0;
     bool is_void_return;
+    bool is_blittable;
+    int im_attributes_pos;
     String *overloaded_name = getOverloadedName(n);
 
     if (!Getattr(n, "sym:overloaded")) {
@@ -777,11 +779,13 @@ public:
     }
 
     Printv(imclass_class_code, "\n  [DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
+    im_attributes_pos = Len(imclass_class_code);
 
     if (im_outattributes)
       Printf(imclass_class_code, "  %s\n", im_outattributes);
 
     Printf(imclass_class_code, "  public static extern %s %s(", im_return_type, overloaded_name);
+    is_blittable = !im_outattributes && (Cmp(im_return_type, "void") == 0 || isBlittableImType(im_return_type));
 
 
     /* Get number of required and total arguments */
@@ -814,6 +818,8 @@ public:
       if ((tm = Getattr(p, "tmap:imtype"))) {
 	const String *inattributes = Getattr(p, "tmap:imtype:inattributes");
 	Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
+	if (inattributes || !isBlittableImType(tm))
+	  is_blittable = false;
       } else {
 	Swig_warning(WARN_CSHARP_TYPEMAP_CSTYPE_UNDEF, input_file, line_number, "No imtype typemap defined for %s\n", SwigType_str(pt, 0));
       }
@@ -1013,6 +1019,20 @@ public:
 		       "Unmanaged code contains a call to a SWIG_CSharpSetPendingException method and C# code does not handle pending exceptions via the canthrow attribute.\n");
 	}
       }
+
+      // %cssuppressgctransition: the p/invoke call skips the GC transition, which is only safe when
+      // no marshaling is needed and the unmanaged code cannot call back into the runtime to set a pending exception
+      if (GetFlag(n, "feature:cs:suppressgctransition")) {
+	if (!is_blittable) {
+	  Swig_warning(WARN_CSHARP_SUPPRESSGCTRANSITION, input_file, line_number,
+		       "SuppressGCTransition not used for %s as its intermediary class types are not all blittable.\n", Swig_name_decl(n));
+	} else if (Getattr(n, "csharp:canthrow")) {
+	  Swig_warning(WARN_CSHARP_SUPPRESSGCTRANSITION, input_file, line_number,
+		       "SuppressGCTransition not used for %s as it can throw a C# exception.\n", Swig_name_decl(n));
+	} else {
+	  Insert(imclass_class_code, im_attributes_pos, "  [System.Runtime.InteropServices.SuppressGCTransition]\n");
+	}
+      }
     }
 
     if (!(proxy_flag && is_wrapping_class()) && !enum_constant_flag) {
@@ -3242,6 +3262,32 @@ public:
     return tm;
   }
 
+  /* -----------------------------------------------------------------------------
+   * isBlittableImType()
+   *
+   * Determine whether an intermediary class type is passed between managed and unmanaged
+   * code without any marshaling: the primitive numeric types (not bool or char), IntPtr,
+   * unsafe pointers and by reference parameters of these types.
+   * ----------------------------------------------------------------------------- */
+
+  bool isBlittableImType(const String *imtype) {
+    static const char *blittable_types[] = {
+      "sbyte", "byte", "short", "ushort", "int", "uint", "long", "ulong", "float", "double",
+      "IntPtr", "UIntPtr", "System.IntPtr", "System.UIntPtr", "global::System.IntPtr", "global::System.UIntPtr", 0
+    };
+    const char *c = Char(imtype);
+    if (strncmp(c, "ref ", 4) == 0 || strncmp(c, "out ", 4) == 0)
+      c += 4;
+    size_t len = strlen(c);
+    if (len > 0 && c[len - 1] == '*')
+      return true;
+    for (int i = 0; blittable_types[i]; i++) {
+      if (strcmp(c, blittable_types[i]) == 0)
+	return true;
+    }
+    return false;
+  }
+
   /* -----------------------------------------------------------------------------
    * canThrow()
    * Determine whether the code in the typemap can throw a C# exception.
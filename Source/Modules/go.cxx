@@ -20,6 +20,8 @@ class GO:public Language {
   String *module;
   // Flag for generating gccgo output.
   bool gccgo_flag;
+  // Flag for generating batched entry points for all eligible functions.
+  bool batch_flag;
   // Prefix to use with gccgo.
   String *go_prefix;
   // Name of shared library to import.
@@ -74,6 +76,9 @@ class GO:public Language {
   bool making_variable_wrappers;
   // True when working with a static member function.
   bool is_static_member_function;
+  // True when the function wrappers being written are for a leaf
+  // function, which is called without telling the Go scheduler.
+  bool making_leaf_wrappers;
   // A hash table of types that we have seen but which may not have
   // been defined.  The index is a SwigType.
   Hash *undefined_types;
@@ -85,6 +90,7 @@ public:
   GO():package(NULL),
      module(NULL),
      gccgo_flag(false),
+     batch_flag(false),
      go_prefix(NULL),
      soname(NULL),
      long_type_size(32),
@@ -113,6 +119,7 @@ public:
      class_methods(NULL),
      making_variable_wrappers(false),
      is_static_member_function(false),
+     making_leaf_wrappers(false),
      undefined_types(NULL),
      defined_types(NULL) {
     director_multiple_inheritance = 1;
@@ -144,6 +151,9 @@ private:
 	} else if (strcmp(argv[i], "-gccgo") == 0) {
 	  Swig_mark_arg(i);
 	  gccgo_flag = true;
+	} else if (strcmp(argv[i], "-batch") == 0) {
+	  Swig_mark_arg(i);
+	  batch_flag = true;
 	} else if (strcmp(argv[i], "-go-prefix") == 0) {
 	  if (argv[i + 1]) {
 	    go_prefix = NewString(argv[i + 1]);
@@ -728,28 +738,52 @@ private:
 
     assert(result);
 
-    bool needs_wrapper;
-    int r = goFunctionWrapper(n, name, go_name, overname, wname, base, parms, result, is_static, &needs_wrapper);
-    if (r != SWIG_OK) {
-      return r;
+    String *nodetype = Getattr(n, "nodeType");
+    bool is_ctor_dtor = Cmp(nodetype, "constructor") == 0 || Cmp(nodetype, "destructor") == 0;
+    bool is_scalar = !base && !is_ctor_dtor && hasOnlyScalars(n, parms, result);
+
+    // A leaf function must not block or call back into Go, which SWIG
+    // cannot check, so this is only done for %feature("go:leaf").
+    bool is_leaf = GetFlag(n, "feature:go:leaf") ? true : false;
+    if (is_leaf && !is_scalar) {
+      Swig_warning(WARN_GO_FEATURE_IGNORED, input_file, line_number, "%%feature(\"go:leaf\") ignored for %s, it only applies to functions with scalar parameters and result\n", Swig_name_decl(n));
+      is_leaf = false;
     }
 
-    if (!gccgo_flag) {
-      r = gcFunctionWrapper(n, name, go_name, overname, wname, parms, result, is_static, needs_wrapper);
-      if (r != SWIG_OK) {
-	return r;
+    String *batch_feature = Getattr(n, "feature:go:batch");
+    bool is_batch = batch_feature ? GetFlag(n, "feature:go:batch") : batch_flag;
+    if (is_batch && !is_scalar) {
+      if (batch_feature) {
+	Swig_warning(WARN_GO_FEATURE_IGNORED, input_file, line_number, "%%feature(\"go:batch\") ignored for %s, it only applies to functions with scalar parameters and result\n", Swig_name_decl(n));
       }
-      r = gccFunctionWrapper(n, base, wname, parms, result);
-      if (r != SWIG_OK) {
-	return r;
-      }
-    } else {
-      r = gccgoFunctionWrapper(n, base, wname, parms, result);
-      if (r != SWIG_OK) {
-	return r;
+      is_batch = false;
+    }
+
+    assert(!making_leaf_wrappers);
+    making_leaf_wrappers = is_leaf;
+
+    bool needs_wrapper;
+    int r = goFunctionWrapper(n, name, go_name, overname, wname, base, parms, result, is_static, &needs_wrapper);
+    if (r == SWIG_OK) {
+      if (!gccgo_flag) {
+	r = gcFunctionWrapper(n, name, go_name, overname, wname, parms, result, is_static, needs_wrapper);
+	if (r == SWIG_OK) {
+	  r = gccFunctionWrapper(n, base, wname, parms, result);
+	}
+      } else {
+	r = gccgoFunctionWrapper(n, base, wname, parms, result);
       }
     }
 
+    making_leaf_wrappers = false;
+
+    if (r == SWIG_OK && is_batch) {
+      r = batchFunctionWrappers(n, name, overname, wname, parms, result);
+    }
+    if (r != SWIG_OK) {
+      return r;
+    }
+
     if (class_methods) {
       Setattr(class_methods, Getattr(n, "name"), NewString(""));
     }
@@ -983,7 +1017,7 @@ private:
 	}
       }
 
-      if (gccgo_flag) {
+      if (gccgo_flag && !making_leaf_wrappers) {
 	if (!is_constructor) {
 	  Printv(f_go_wrappers, "\tdefer SwigCgocallDone()\n", NULL);
 	  Printv(f_go_wrappers, "\tSwigCgocall()\n", NULL);
@@ -1131,7 +1165,13 @@ private:
     Delete(parm_size);
 
     Printv(f->code, "{\n", NULL);
-    Printv(f->code, "\truntime\xc2\xb7" "cgocall(x", wname, ", &p);\n", NULL);
+    if (making_leaf_wrappers) {
+      // A leaf function does not block or call back into Go, so it
+      // can simply be run on the scheduler stack.
+      Printv(f->code, "\truntime\xc2\xb7" "asmcgocall(x", wname, ", &p);\n", NULL);
+    } else {
+      Printv(f->code, "\truntime\xc2\xb7" "cgocall(x", wname, ", &p);\n", NULL);
+    }
     Printv(f->code, "}\n", NULL);
     Printv(f->code, "\n", NULL);
 
@@ -1429,6 +1469,215 @@ private:
     return SWIG_OK;
   }
 
+  /* ----------------------------------------------------------------------
+   * hasOnlyScalars()
+   *
+   * Return whether a function can be a leaf function or have a
+   * batched entry point: it must have no optional parameters, and no
+   * parameters or result which are Go strings or slices, as those
+   * refer to memory managed by Go.
+   * ---------------------------------------------------------------------- */
+
+  bool hasOnlyScalars(Node *n, ParmList *parms, SwigType *result) {
+    Wrapper *dummy = NewWrapper();
+    emit_attach_parmmaps(parms, dummy);
+    Swig_typemap_attach_parms("default", parms, dummy);
+    Swig_typemap_attach_parms("gotype", parms, dummy);
+    int parm_count = emit_num_arguments(parms);
+    int required_count = emit_num_required(parms);
+
+    bool ret = parm_count == required_count;
+    Parm *p = parms;
+    for (int i = 0; ret && i < parm_count; ++i) {
+      p = getParm(p);
+      ret = goTypeIsScalar(p, Getattr(p, "type"));
+      p = nextParm(p);
+    }
+    if (ret && SwigType_type(result) != T_VOID) {
+      ret = goTypeIsScalar(n, result);
+    }
+
+    DelWrapper(dummy);
+    return ret;
+  }
+
+  bool goTypeIsScalar(Node *n, SwigType *type) {
+    String *gt = goType(n, type);
+    bool ret = Strcmp(gt, "string") != 0 && Strncmp(gt, "[]", 2) != 0;
+    Delete(gt);
+    return ret;
+  }
+
+  /* ----------------------------------------------------------------------
+   * batchFunctionWrappers()
+   *
+   * Write out a batched entry point for a function, which calls it
+   * once for each element of a slice of argument structs, all within
+   * a single cgo call.  For a function foo this generates
+   *
+   *   type FooBatchArgs struct { Arg1 T1; ...; Result R }
+   *   func FooBatch(args []FooBatchArgs)
+   *
+   * The struct has the same layout as the arguments of the function
+   * wrapper written by gccFunctionWrapper, so for 6g/8g the C code
+   * simply calls that wrapper for each element.  For gccgo the C code
+   * unpacks each element and calls the gccgo wrapper.
+   * ---------------------------------------------------------------------- */
+
+  int batchFunctionWrappers(Node *n, String *name, String *overname, String *wname, ParmList *parms, SwigType *result) {
+    Wrapper *dummy = NewWrapper();
+    emit_attach_parmmaps(parms, dummy);
+    int parm_count = emit_num_arguments(parms);
+    bool has_result = SwigType_type(result) != T_VOID;
+
+    String *batch_name = exportedName(name);
+    if (overname) {
+      Append(batch_name, overname);
+    }
+    Append(batch_name, "Batch");
+    String *args_name = NewStringf("%sArgs", batch_name);
+    String *wrapper_name = buildGoWrapperName(name, overname);
+    Append(wrapper_name, "Batch");
+    String *batch_wname = NewStringf("%s_batch", wname);
+
+    // The batched entry point is an extra, so a Go name conflict only
+    // drops it, not the function itself.
+    String *conflict = batch_name;
+    Node *lk = symbolLookup(conflict, NULL);
+    if (!lk) {
+      conflict = args_name;
+      lk = symbolLookup(conflict, NULL);
+    }
+    if (lk) {
+      String *n2 = Getattr(lk, "sym:name");
+      if (!n2) {
+	n2 = Getattr(lk, "name");
+      }
+      Swig_warning(WARN_GO_NAME_CONFLICT, input_file, line_number,
+		   "Ignoring batched entry point for '%s' due to Go name ('%s') conflict with '%s'\n",
+		   Getattr(n, "sym:name"), conflict, n2);
+      Delete(batch_wname);
+      Delete(wrapper_name);
+      Delete(args_name);
+      Delete(batch_name);
+      DelWrapper(dummy);
+      return SWIG_OK;
+    }
+    addSymbol(batch_name, n, NULL);
+    addSymbol(args_name, n, NULL);
+
+    // The Go argument struct.
+
+    Printv(f_go_wrappers, "type ", args_name, " struct {\n", NULL);
+    Parm *p = parms;
+    for (int i = 0; i < parm_count; ++i) {
+      p = getParm(p);
+      String *field = exportedName(Getattr(p, "lname"));
+      String *tm = goWrapperType(p, Getattr(p, "type"), false);
+      Printv(f_go_wrappers, "\t", field, " ", tm, "\n", NULL);
+      Delete(tm);
+      Delete(field);
+      p = nextParm(p);
+    }
+    if (has_result) {
+      // Results are aligned like the C wrapper's "long : 0".
+      String *tm = goWrapperType(n, result, true);
+      Printv(f_go_wrappers, "\t_ [0]uintptr\n", NULL);
+      Printv(f_go_wrappers, "\tResult ", tm, "\n", NULL);
+      Delete(tm);
+    }
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    // The Go functions.
+
+    if (gccgo_flag) {
+      Printv(f_go_wrappers, "//extern ", go_prefix, "_", batch_wname, "\n", NULL);
+    }
+    Printv(f_go_wrappers, "func ", wrapper_name, "([]", args_name, ", uintptr)\n\n", NULL);
+
+    Printv(f_go_wrappers, "func ", batch_name, "(args []", args_name, ") {\n", NULL);
+    if (gccgo_flag) {
+      Printv(f_go_wrappers, "\tdefer SwigCgocallDone()\n", NULL);
+      Printv(f_go_wrappers, "\tSwigCgocall()\n", NULL);
+    }
+    Printv(f_go_wrappers, "\t", wrapper_name, "(args, unsafe.Sizeof(", args_name, "{}))\n", NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    // The C functions.
+
+    if (!gccgo_flag) {
+      Printv(f_gc_wrappers, "#pragma dynimport ", batch_wname, " ", batch_wname, " \"\"\n", NULL);
+      Printv(f_gc_wrappers, "extern void (*", batch_wname, ")(void*);\n", NULL);
+      Printv(f_gc_wrappers, "static void (*x", batch_wname, ")(void*) = ", batch_wname, ";\n", NULL);
+      Printv(f_gc_wrappers, "\n", NULL);
+      Printv(f_gc_wrappers, "void\n", NULL);
+      Printv(f_gc_wrappers, "\xc2\xb7", wrapper_name, "(struct { uint8 x[(3 * SWIG_PARM_SIZE) + SWIG_PARM_SIZE];} p)\n", NULL);
+      Printv(f_gc_wrappers, "{\n", NULL);
+      Printv(f_gc_wrappers, "\truntime\xc2\xb7" "cgocall(x", batch_wname, ", &p);\n", NULL);
+      Printv(f_gc_wrappers, "}\n\n", NULL);
+
+      Printv(f_c_wrappers, "void\n", batch_wname, "(void *swig_v)\n", "{\n", NULL);
+      Printv(f_c_wrappers, "\tstruct swigargs {\n", NULL);
+      Printv(f_c_wrappers, "\t\t_goslice_ args;\n", NULL);
+      Printv(f_c_wrappers, "\t\tsize_t size;\n", NULL);
+      Printv(f_c_wrappers, "\t} *swig_a = (struct swigargs *) swig_v;\n", NULL);
+      Printv(f_c_wrappers, "\tchar *swig_p = (char *) swig_a->args.array;\n", NULL);
+      Printv(f_c_wrappers, "\tintgo swig_i;\n\n", NULL);
+      Printv(f_c_wrappers, "\tfor (swig_i = 0; swig_i < swig_a->args.len; swig_i++) {\n", NULL);
+      Printv(f_c_wrappers, "\t\t", wname, "(swig_p);\n", NULL);
+      Printv(f_c_wrappers, "\t\tswig_p += swig_a->size;\n", NULL);
+      Printv(f_c_wrappers, "\t}\n", NULL);
+      Printv(f_c_wrappers, "}\n\n", NULL);
+    } else {
+      Printv(f_c_wrappers, "void\n", go_prefix, "_", batch_wname, "(_goslice_ swig_args, size_t swig_size)\n", "{\n", NULL);
+      Printv(f_c_wrappers, "  char *swig_p = (char *) swig_args.array;\n", NULL);
+      Printv(f_c_wrappers, "  intgo swig_i;\n\n", NULL);
+      Printv(f_c_wrappers, "  for (swig_i = 0; swig_i < swig_args.len; swig_i++) {\n", NULL);
+      Printv(f_c_wrappers, "    struct swigargs {\n", NULL);
+      String *call = NewString("");
+      Printv(call, go_prefix, "_", wname, "(", NULL);
+      p = parms;
+      for (int i = 0; i < parm_count; ++i) {
+	p = getParm(p);
+	SwigType *pt = Copy(Getattr(p, "type"));
+	if (SwigType_isarray(pt)) {
+	  SwigType_del_array(pt);
+	  SwigType_add_pointer(pt);
+	}
+	String *ln = Getattr(p, "lname");
+	String *ct = gccgoCTypeForGoValue(p, pt, ln);
+	Printv(f_c_wrappers, "      ", ct, ";\n", NULL);
+	Printv(call, i > 0 ? ", " : "", "swig_a->", ln, NULL);
+	Delete(ct);
+	Delete(pt);
+	p = nextParm(p);
+      }
+      Printv(call, ")", NULL);
+      if (has_result) {
+	String *ln = NewString("result");
+	String *ct = gccgoCTypeForGoValue(n, result, ln);
+	Printv(f_c_wrappers, "      long : 0;\n", NULL);
+	Printv(f_c_wrappers, "      ", ct, ";\n", NULL);
+	Delete(ct);
+	Delete(ln);
+      }
+      Printv(f_c_wrappers, "    } *swig_a = (struct swigargs *) swig_p;\n", NULL);
+      Printv(f_c_wrappers, "    ", has_result ? "swig_a->result = " : "", call, ";\n", NULL);
+      Printv(f_c_wrappers, "    swig_p += swig_size;\n", NULL);
+      Printv(f_c_wrappers, "  }\n", NULL);
+      Printv(f_c_wrappers, "}\n\n", NULL);
+      Delete(call);
+    }
+
+    Delete(batch_wname);
+    Delete(wrapper_name);
+    Delete(args_name);
+    Delete(batch_name);
+    DelWrapper(dummy);
+
+    return SWIG_OK;
+  }
+
   /* -----------------------------------------------------------------------
    * checkConstraints()
    *
@@ -4894,6 +5143,7 @@ extern "C" Language *swig_go(void) {
 // Usage message.
 const char * const GO::usage = (char *) "\
 Go Options (available with -go)\n\
+     -batch              - Generate batched entry points for functions with scalar parameters\n\
      -gccgo              - Generate code for gccgo rather than 6g/8g\n\
      -go-prefix <p>      - Like gccgo -fgo-prefix option\n\
      -longsize <s>       - Set size of C/C++ long type--32 or 64 bits\n\
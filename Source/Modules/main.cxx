@@ -58,11 +58,13 @@ static const char *usage1 = (const char *) "\
 \nGeneral Options\n\
      -addextern      - Add extra extern declarations\n\
      -c++            - Enable C++ processing\n\
+     -cachedir <dir> - Cache preprocessor output in <dir> for reuse by later runs\n\
      -co <file>      - Check <file> out of the SWIG library\n\
      -copyctor       - Automatically generate copy constructors wherever possible\n\
      -cpperraswarn   - Treat the preprocessor #error statement as #warning (default)\n\
      -copyright      - Display copyright notices\n\
      -debug-classes  - Display information about the classes found in the interface\n\
+     -debug-features-stats - Display feature lookup cache statistics\n\
      -debug-module <n>- Display module parse tree at stages 1-4, <n> is a csv list of stages\n\
      -debug-symtabs  - Display symbol tables information\n\
      -debug-symbols  - Display target language symbols in the symbol tables\n\
@@ -163,6 +165,7 @@ static char *hpp_extension = (char *) "h";
 static char *cpp_extension = (char *) "cxx";
 static char *depends_extension = (char *) "d";
 static String *outdir = 0;
+static String *cache_dir = 0;
 static String *xmlout = 0;
 static int outcurrentdir = 0;
 static int help = 0;
@@ -172,6 +175,8 @@ static int no_cpp = 0;
 static String *outfile_name = 0;
 static String *outfile_name_h = 0;
 static int tm_debug = 0;
+static int tm_search_debug = 0;
+static int features_stats_debug = 0;
 static int dump_symtabs = 0;
 static int dump_symbols = 0;
 static int dump_csymbols = 0;
@@ -259,6 +264,26 @@ static void install_opts(int argc, char *argv[]) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * cache_output_option()
+ *
+ * Returns the number of arguments taken by an option which only names output
+ * files, so its arguments can be left out of the preprocessor cache key, or
+ * -1 for any other option.
+ * ----------------------------------------------------------------------------- */
+
+static int cache_output_option(const char *arg) {
+  static const char *options[] = { "-o", "-oh", "-outdir", "-xmlout", "-cachedir", "-MF", "-MT", 0 };
+  int i;
+  for (i = 0; options[i]; i++) {
+    if (strcmp(arg, options[i]) == 0)
+      return 1;
+  }
+  if (strcmp(arg, "-MP") == 0)
+    return 0;
+  return -1;
+}
+
 /* -----------------------------------------------------------------------------
  * decode_numbers_list()
  *
@@ -680,6 +705,10 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-debug-tmsearch") == 0) {
 	Swig_typemap_search_debug_set();
+	tm_search_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-features-stats") == 0) {
+	features_stats_debug = 1;
 	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-debug-tmused") == 0) {
 	Swig_typemap_used_debug_set();
@@ -736,6 +765,14 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	} else {
 	  Swig_arg_error();
 	}
+      } else if (strcmp(argv[i], "-cachedir") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  cache_dir = NewString(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-outcurrentdir") == 0) {
 	Swig_mark_arg(i);
 	outcurrentdir = 1;
@@ -826,6 +863,7 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	browse = 1;
 	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-typedef") == 0) || (strcmp(argv[i], "-dump_typedef") == 0)) {
+	SwigType_typedef_cache_debug_set();
 	dump_typedef = 1;
 	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-classes") == 0) || (strcmp(argv[i], "-dump_classes") == 0)) {
@@ -1056,7 +1094,29 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	  Printf(fs, "\n%%include \"%s\"\n", Swig_filename_escape(Getitem(libfiles, i)));
 	}
 	Seek(fs, 0, SEEK_SET);
-	cpps = Preprocessor_parse(fs);
+	if (cache_dir) {
+	  // Everything on the command line can affect the preprocessor output, except for the names of output files
+	  String *options = NewString("");
+	  for (i = 0; i < argc; i++) {
+	    int nargs = cache_output_option(argv[i]);
+	    if (nargs > 0 && i + nargs < argc) {
+	      // The option defines a SWIGOPT macro holding the file name, see install_opts()
+	      String *macro = NewStringf("SWIGOPT%(upper)s", argv[i]);
+	      Replaceall(macro, "-", "_");
+	      Preprocessor_cache_volatile(macro);
+	      Delete(macro);
+	      Printf(options, "%s\n", argv[i]);
+	      i += nargs;
+	      continue;
+	    }
+	    if (nargs == 0)
+	      continue;
+	    Printf(options, "%s\n", argv[i]);
+	  }
+	  Preprocessor_cache_dir(cache_dir, options);
+	  Delete(options);
+	}
+	cpps = Preprocessor_cache_parse(fs);
 	Delete(fs);
       } else {
 	cpps = Swig_read_file(df);
@@ -1293,6 +1353,12 @@ int SWIG_main(int argc, char *argv[], Language *l) {
   }
   if (tm_debug)
     Swig_typemap_debug();
+  if (tm_search_debug)
+    Swig_typemap_search_debug_stats();
+  if (dump_typedef)
+    SwigType_typedef_cache_debug_stats();
+  if (features_stats_debug)
+    Swig_features_debug_stats();
   if (memory_debug)
     DohMemoryDebug();
 
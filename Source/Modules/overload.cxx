@@ -537,11 +537,59 @@ String *Swig_overload_dispatch_cast(Node *n, const_String_or_char_ptr fmt, int *
   return f;
 }
 
+/* -----------------------------------------------------------------------------
+ * next_input_parm()
+ *
+ * Step to the parameter following pj, skipping over multi-argument typemaps.
+ * ----------------------------------------------------------------------------- */
+
+static Parm *next_input_parm(Parm *pj) {
+  Parm *pj1 = Getattr(pj, "tmap:in:next");
+  return pj1 ? pj1 : nextSibling(pj);
+}
+
+/* -----------------------------------------------------------------------------
+ * input_typecheck()
+ *
+ * Return the normalised typecheck typemap for input argument j of the
+ * overloaded wrapper ni, or 0 if there is none.
+ * ----------------------------------------------------------------------------- */
+
+static String *input_typecheck(Node *ni, int j, Parm **parm) {
+  Parm *pj = Getattr(ni, "wrap:parms");
+  int l = 0;
+  while (pj) {
+    if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
+      pj = Getattr(pj, "tmap:in:next");
+      continue;
+    }
+    if (l == j) {
+      String *tm = Getattr(pj, "tmap:typecheck");
+      /* normalise for comparison */
+      if (tm)
+	Replaceid(tm, Getattr(pj, "lname"), "_v");
+      if (parm)
+	*parm = pj;
+      return tm;
+    }
+    pj = next_input_parm(pj);
+    l++;
+  }
+  return 0;
+}
+
 /*
   Fast dispatch mechanism, provided by  Salvador Fandi~no Garc'ia (#930586).
+
+  The dispatcher switches on the argument count first, so that only the
+  overloads accepting that many arguments are considered, in ranked order.
+  Within a case an argument is only type checked if a later candidate has a
+  different typecheck for it, and the last candidate is called without any
+  checks. A typecheck shared by several candidates for the same argument is
+  evaluated at most once per call, its result is kept in a _c<n> variable.
 */
 String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *maxargs) {
-  int i, j;
+  int i, j, k;
 
   *maxargs = 1;
 
@@ -550,146 +598,158 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
   /* Get a list of methods ranked by precedence values and argument count */
   List *dispatch = Swig_overload_rank(n, true);
   int nfunc = Len(dispatch);
-
-  /* Loop over the functions */
+  int min_required = -1;
 
   for (i = 0; i < nfunc; i++) {
-    int fn = 0;
     Node *ni = Getitem(dispatch, i);
     Parm *pi = Getattr(ni, "wrap:parms");
     int num_required = emit_num_required(pi);
     int num_arguments = emit_num_arguments(pi);
     if (num_arguments > *maxargs)
       *maxargs = num_arguments;
+    if (min_required < 0 || num_required < min_required)
+      min_required = num_required;
 
-    if (num_required == num_arguments) {
-      Printf(f, "if (%s == %d) {\n", argc_template_string, num_required);
-    } else {
-      Printf(f, "if ((%s >= %d) && (%s <= %d)) {\n", argc_template_string, num_required, argc_template_string, num_arguments);
-    }
-
-    /* create a list with the wrappers that collide with the
-       current one based on argument number */
-    List *coll = NewList();
-    for (int k = i + 1; k < nfunc; k++) {
-      Node *nk = Getitem(dispatch, k);
-      Parm *pk = Getattr(nk, "wrap:parms");
+    /* warn once per method if an argument would need a typecheck that does not exist */
+    bool collides = false;
+    for (k = i + 1; k < nfunc && !collides; k++) {
+      Parm *pk = Getattr(Getitem(dispatch, k), "wrap:parms");
       int nrk = emit_num_required(pk);
       int nak = emit_num_arguments(pk);
       if ((nrk >= num_required && nrk <= num_arguments) || (nak >= num_required && nak <= num_arguments) || (nrk <= num_required && nak >= num_arguments))
-	Append(coll, nk);
+	collides = true;
     }
-
-    // printf("overload: %s coll=%d\n", Char(Getattr(n, "sym:name")), Len(coll));
-
-    int num_braces = 0;
-    bool test = (Len(coll) > 0 && num_arguments);
-    if (test) {
-      int need_v = 1;
+    if (collides && num_arguments) {
       j = 0;
-      Parm *pj = pi;
-      while (pj) {
+      for (Parm *pj = pi; pj; ) {
 	if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
 	  pj = Getattr(pj, "tmap:in:next");
 	  continue;
 	}
-
-	String *tm = Getattr(pj, "tmap:typecheck");
-	if (tm) {
-	  /* normalise for comparison later */
-	  Replaceid(tm, Getattr(pj, "lname"), "_v");
-
-	  /* if all the wrappers have the same type check on this
-	     argument we can optimize it out */
-	  bool emitcheck = 0;
-	  for (int k = 0; k < Len(coll) && !emitcheck; k++) {
-	    Node *nk = Getitem(coll, k);
-	    Parm *pk = Getattr(nk, "wrap:parms");
-	    int nak = emit_num_arguments(pk);
-	    if (nak <= j)
-	      continue;
-	    int l = 0;
-	    Parm *pl = pk;
-	    /* finds arg j on the collider wrapper */
-	    while (pl && l <= j) {
-	      if (checkAttribute(pl, "tmap:in:numinputs", "0")) {
-		pl = Getattr(pl, "tmap:in:next");
-		continue;
-	      }
-	      if (l == j) {
-		/* we are at arg j, so we compare the tmaps now */
-		String *tml = Getattr(pl, "tmap:typecheck");
-		/* normalise it before comparing */
-		if (tml)
-		  Replaceid(tml, Getattr(pl, "lname"), "_v");
-		if (!tml || Cmp(tm, tml))
-		  emitcheck = 1;
-		//printf("tmap: %s[%d] (%d) => %s\n\n",
-		//       Char(Getattr(nk, "sym:name")),
-		//       l, emitcheck, tml?Char(tml):0);
-	      }
-	      Parm *pl1 = Getattr(pl, "tmap:in:next");
-	      if (pl1)
-		pl = pl1;
-	      else
-		pl = nextSibling(pl);
-	      l++;
-	    }
-	  }
-
-	  if (emitcheck) {
-	    if (need_v) {
-	      Printf(f, "int _v = 0;\n");
-	      need_v = 0;
-	    }
-	    if (j >= num_required) {
-	      Printf(f, "if (%s > %d) {\n", argc_template_string, j);
-	      num_braces++;
-	    }
-	    String *tmp = NewStringf(argv_template_string, j);
-
-	    String *conv = Getattr(pj, "implicitconv");
-	    if (conv) {
-	      Replaceall(tm, "$implicitconv", conv);
-	    } else {
-	      Replaceall(tm, "$implicitconv", "0");
-	    }
-	    Replaceall(tm, "$input", tmp);
-	    Printv(f, "{\n", tm, "}\n", NIL);
-	    fn = i + 1;
-	    Printf(f, "if (!_v) goto check_%d;\n", fn);
-	  }
-	}
 	if (!Getattr(pj, "tmap:in:SWIGTYPE") && Getattr(pj, "tmap:typecheck:SWIGTYPE")) {
 	  /* we emit  a warning if the argument defines the 'in' typemap, but not the 'typecheck' one */
 	  Swig_warning(WARN_TYPEMAP_TYPECHECK_UNDEF, Getfile(ni), Getline(ni),
 		       "Overloaded method %s with no explicit typecheck typemap for arg %d of type '%s'\n",
 		       Swig_name_decl(n), j, SwigType_str(Getattr(pj, "type"), 0));
 	}
-	Parm *pj1 = Getattr(pj, "tmap:in:next");
-	if (pj1)
-	  pj = pj1;
-	else
-	  pj = nextSibling(pj);
+	pj = next_input_parm(pj);
 	j++;
       }
     }
+  }
 
-    /* close braces */
-    for ( /* empty */ ; num_braces > 0; num_braces--)
-      Printf(f, "}\n");
+  Printf(f, "switch (%s) {\n", argc_template_string);
+  for (int argc = min_required; nfunc && argc <= *maxargs; argc++) {
+    /* the candidates for this argument count, in ranked order */
+    List *cand = NewList();
+    for (i = 0; i < nfunc; i++) {
+      Parm *pi = Getattr(Getitem(dispatch, i), "wrap:parms");
+      if (emit_num_required(pi) <= argc && argc <= emit_num_arguments(pi))
+	Append(cand, Getitem(dispatch, i));
+    }
+    int ncand = Len(cand);
+    if (!ncand) {
+      Delete(cand);
+      continue;
+    }
 
+    /* decide which checks are needed and how often each is used */
+    Hash *slots = NewHash();
+    Hash *uses = NewHash();
+    List *checks = NewList();
+    for (i = 0; i < ncand - 1; i++) {
+      List *ci = NewList();
+      for (j = 0; j < argc; j++) {
+	Parm *pj = 0;
+	String *tm = input_typecheck(Getitem(cand, i), j, &pj);
+	if (!tm)
+	  continue;
+	/* if all the later candidates have the same type check on this argument we can optimize it out */
+	bool emitcheck = false;
+	for (k = i + 1; k < ncand && !emitcheck; k++) {
+	  String *tmk = input_typecheck(Getitem(cand, k), j, 0);
+	  if (!tmk || Cmp(tm, tmk))
+	    emitcheck = true;
+	}
+	if (emitcheck) {
+	  String *key = NewStringf("%d:%s:%s", j, Getattr(pj, "implicitconv"), tm);
+	  String *count = Getattr(uses, key);
+	  String *ncount = NewStringf("%d", count ? atoi(Char(count)) + 1 : 1);
+	  String *arg = NewStringf("%d", j);
+	  Setattr(uses, key, ncount);
+	  Append(ci, arg);
+	  Delete(arg);
+	  Delete(ncount);
+	  Delete(key);
+	}
+      }
+      Append(checks, ci);
+      Delete(ci);
+    }
 
-    String *lfmt = ReplaceFormat(fmt, num_arguments);
-    Printf(f, Char(lfmt), Getattr(ni, "wrap:name"));
+    String *body = NewString("");
+    int nslots = 0;
+    bool need_v = false;
+    for (i = 0; i < ncand; i++) {
+      Node *ni = Getitem(cand, i);
+      List *ci = (i < ncand - 1) ? Getitem(checks, i) : 0;
+      int nchecks = ci ? Len(ci) : 0;
+      String *label = NewStringf("check_%d_%d", argc, i + 1);
+
+      if (nchecks)
+	Printf(body, "{\n");
+      for (k = 0; k < nchecks; k++) {
+	Parm *pj = 0;
+	j = atoi(Char(Getitem(ci, k)));
+	String *tm = Copy(input_typecheck(ni, j, &pj));
+	String *key = NewStringf("%d:%s:%s", j, Getattr(pj, "implicitconv"), tm);
+	String *tmp = NewStringf(argv_template_string, j);
+	String *conv = Getattr(pj, "implicitconv");
+	Replaceall(tm, "$implicitconv", conv ? conv : "0");
+	Replaceall(tm, "$input", tmp);
+	need_v = true;
+	if (atoi(Char(Getattr(uses, key))) > 1) {
+	  /* shared with another candidate, evaluate once */
+	  String *slot = Getattr(slots, key);
+	  if (!slot) {
+	    slot = NewStringf("_c%d", nslots++);
+	    Setattr(slots, key, slot);
+	  }
+	  Printf(body, "if (%s < 0) {\n{\n%s}\n%s = _v ? 1 : 0;\n}\n", slot, tm, slot);
+	  Printf(body, "if (!%s) goto %s;\n", slot, label);
+	} else {
+	  Printv(body, "{\n", tm, "}\n", NIL);
+	  Printf(body, "if (!_v) goto %s;\n", label);
+	}
+	Delete(tmp);
+	Delete(key);
+	Delete(tm);
+      }
 
-    Printf(f, "}\n");		/* braces closes "if" for this method */
-    if (fn)
-      Printf(f, "check_%d:\n\n", fn);
+      String *lfmt = ReplaceFormat(fmt, emit_num_arguments(Getattr(ni, "wrap:parms")));
+      Printf(body, Char(lfmt), Getattr(ni, "wrap:name"));
+      Printf(body, "\n");
+      Delete(lfmt);
+      if (nchecks)
+	Printf(body, "}\n%s:\n", label);
+      Delete(label);
+    }
 
-    Delete(lfmt);
-    Delete(coll);
+    Printf(f, "case %d: {\n", argc);
+    if (need_v)
+      Printf(f, "int _v = 0;\n");
+    for (k = 0; k < nslots; k++)
+      Printf(f, "int _c%d = -1;\n", k);
+    Printf(f, "%s", body);
+    Printf(f, "break;\n}\n");
+
+    Delete(body);
+    Delete(checks);
+    Delete(uses);
+    Delete(slots);
+    Delete(cand);
   }
+  Printf(f, "}\n");
   Delete(dispatch);
   return f;
 }
@@ -84,8 +84,10 @@ static int safecstrings = 0;
 static int dirvtable = 0;
 static int proxydel = 1;
 static int fastunpack = 0;
+static int fastcall = 0;
 static int fastproxy = 0;
 static int fastquery = 0;
+static int fastthis = 0;
 static int fastinit = 0;
 static int olddefs = 0;
 static int modernargs = 0;
@@ -117,10 +119,12 @@ Python Options (available with -python)\n\
      -cppcast        - Enable C++ casting operators (default) \n\
      -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch \n\
      -extranative    - Return extra native C++ wraps for std containers when possible \n\
+     -fastcall       - Use the METH_FASTCALL calling convention for the wrappers (implies -fastunpack) \n\
      -fastinit       - Use fast init mechanism for classes (default)\n\
      -fastunpack     - Use fast unpack mechanism to parse the argument functions \n\
      -fastproxy      - Use fast proxy mechanism for member methods \n\
      -fastquery      - Use fast query mechanism for types \n\
+     -fastthis       - Keep 'this' in a slot of the proxy classes rather than in their __dict__ \n\
      -globals <name> - Set <name> used to access C global variable [default: 'cvar']\n\
      -interface <lib>- Set the lib name to <lib>\n\
      -keyword        - Use keyword arguments\n\
@@ -136,10 +140,12 @@ static const char *usage2 = (char *) "\
      -nodirvtable    - Don't use the virtual table feature, resolve the python method each time (default)\n\
      -noexcept       - No automatic exception handling\n\
      -noextranative  - Don't use extra native C++ wraps for std containers when possible (default) \n\
+     -nofastcall     - Use the traditional argument tuple calling convention for the wrappers (default) \n\
      -nofastinit     - Use traditional init mechanism for classes \n\
      -nofastunpack   - Use traditional UnpackTuple method to parse the argument functions (default) \n\
      -nofastproxy    - Use traditional proxy mechanism for member methods (default) \n\
      -nofastquery    - Use traditional query mechanism for types (default) \n\
+     -nofastthis     - Keep 'this' in the __dict__ of the proxy classes (default) \n\
      -noh            - Don't generate the output header file\n\
      -nomodern       - Don't use modern python features which are not backwards compatible \n\
      -nomodernargs   - Use classic ParseTuple/CallFunction methods to pack/unpack the function arguments (default) \n";
@@ -422,6 +428,14 @@ public:
 	} else if (strcmp(argv[i], "-nofastunpack") == 0) {
 	  fastunpack = 0;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastcall") == 0) {
+	  fastcall = 1;
+	  fastunpack = 1;
+	  modernargs = 1;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-nofastcall") == 0) {
+	  fastcall = 0;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-fastproxy") == 0) {
 	  fastproxy = 1;
 	  Swig_mark_arg(i);
@@ -434,6 +448,12 @@ public:
 	} else if (strcmp(argv[i], "-nofastquery") == 0) {
 	  fastquery = 0;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastthis") == 0) {
+	  fastthis = 1;
+	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-nofastthis") == 0) {
+	  fastthis = 0;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-fastinit") == 0) {
 	  fastinit = 1;
 	  Swig_mark_arg(i);
@@ -530,6 +550,11 @@ public:
       classic = 0;
     }
 
+    if (builtin) {
+      /* builtin types keep 'this' in the object itself */
+      fastthis = 0;
+    }
+
     if (cppcast) {
       Preprocessor_define((DOH *) "SWIG_CPLUSPLUS_CAST", 0);
     }
@@ -710,6 +735,10 @@ public:
       Printf(f_runtime, "#define SWIGPYTHON_BUILTIN\n");
     }
 
+    if (fastthis) {
+      Printf(f_runtime, "#define SWIG_PYTHON_FASTTHIS\n");
+    }
+
     Printf(f_runtime, "\n");
 
     Printf(f_header, "#if (PY_VERSION_HEX <= 0x02000000)\n");
@@ -852,11 +881,14 @@ public:
       /* if (!modern) */
       /* always needed, a class can be forced to be no-modern, such as an exception */
       {
+	/* With -fastthis the 'this' slot of SwigPyProxy hides any 'this' in the __dict__ */
+	const char *set_this = fastthis && !classic ? "if isinstance(self, _SwigPyProxy): _SwigPyProxy.this.__set__(self, value)\n"
+	    tab4 tab8 "else: self.__dict__[name] = value\n" : "self.__dict__[name] = value\n";
 	// Python-2.2 object hack
 	Printv(f_shadow,
 	       "def _swig_setattr_nondynamic(self,class_type,name,value,static=1):\n",
 	       tab4, "if (name == \"thisown\"): return self.this.own(value)\n",
-	       tab4, "if (name == \"this\"):\n", tab4, tab4, "if type(value).__name__ == 'SwigPyObject':\n", tab4, tab8, "self.__dict__[name] = value\n",
+	       tab4, "if (name == \"this\"):\n", tab4, tab4, "if type(value).__name__ == 'SwigPyObject':\n", tab4, tab8, set_this,
 #ifdef USE_THISOWN
 	       tab4, tab8, "if hasattr(value,\"thisown\"): self.__dict__[\"thisown\"] = value.thisown\n", tab4, tab8, "del value.thisown\n",
 #endif
@@ -893,6 +925,8 @@ public:
 		 "    _object = object\n", "    _newclass = 1\n", "except AttributeError:\n", "    class _object : pass\n", "    _newclass = 0\n",
 //                 "del types\n", 
 		 "\n\n", NIL);
+	  if (fastthis)
+	    Printf(f_shadow, "_SwigPyProxy = %s._SwigPyProxy\n\n", module);
 	}
       }
       if (modern) {
@@ -1810,7 +1844,9 @@ public:
    * ------------------------------------------------------------ */
 
   void add_method(String *name, String *function, int kw, Node *n = 0, int funpack= 0, int num_required= -1, int num_arguments = -1) {
-    if (!kw) {
+    if (n && GetFlag(n, "python:fastcall")) {
+      Printf(methods, "\t { (char *)\"%s\", (PyCFunction) %s, SWIG_METH_FASTCALL, ", name, function);
+    } else if (!kw) {
       if (n && funpack) {
 	if (num_required == 0 && num_arguments == 0) {
 	  Printf(methods, "\t { (char *)\"%s\", (PyCFunction)%s, METH_NOARGS, ", name, function);
@@ -1873,13 +1909,24 @@ public:
     String *symname = Getattr(n, "sym:name");
     String *wname = Swig_name_wrapper(symname);
 
-    Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args) {", NIL);
+    bool fastcall_dispatch = funpack && GetFlag(n, "python:fastcall");
+    if (fastcall_dispatch)
+      Printv(f->def, linkage, "PyObject *", wname, "(PyObject *self, SWIG_FASTCALL_PARMS) {", NIL);
+    else
+      Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args) {", NIL);
 
     Wrapper_add_local(f, "argc", "int argc");
     Printf(tmp, "PyObject *argv[%d]", maxargs + 1);
     Wrapper_add_local(f, "argv", tmp);
 
-    if (!fastunpack) {
+    if (fastcall_dispatch) {
+      String *iname = Getattr(n, "sym:name");
+      Printf(f->code, "if (!(argc = (int)SWIG_Python_UnpackFastcall(\"%s\", SWIG_FASTCALL_ARGS, 0, 0, 0, %d, argv%s))) SWIG_fail;\n", iname, maxargs, add_self ? "+1" : "");
+      if (add_self)
+	Append(f->code, "argv[0] = self;\n");
+      else
+	Append(f->code, "--argc;\n");
+    } else if (!fastunpack) {
       Wrapper_add_local(f, "ii", "int ii");
       if (maxargs - (add_self ? 1 : 0) > 0)
 	Append(f->code, "if (!PyTuple_Check(args)) SWIG_fail;\n");
@@ -2129,6 +2176,29 @@ public:
     int noargs = funpack && (tuple_required == 0 && tuple_arguments == 0);
     int onearg = funpack && (tuple_required == 1 && tuple_arguments == 1);
 
+    /* With -fastcall the arguments are passed as a C array rather than a
+       tuple, except where METH_NOARGS or METH_O already avoid the tuple.
+       Wrappers called from builtin slots, getters and setters and from
+       tp_init are always called with a tuple. */
+    int fastcall_wrap = 0;
+    Delattr(n, "python:fastcall");
+    if (fastcall && modernargs && fastunpack && !varargs && !over_varargs && !builtin_ctor && !builtin_getter && !builtin_setter
+	&& !Getattr(n, "feature:python:slot") && !Getattr(n, "feature:python:compare")) {
+      if (overname) {
+	SetFlag(n, "python:fastcall");
+      } else if (allow_kwargs || !(noargs || onearg)) {
+	for (p = l; p; p = nextSibling(p)) {
+	  if (Getattr(p, "tmap:in:parse"))
+	    break;
+	}
+	if (!p) {
+	  fastcall_wrap = 1;
+	  funpack = 1;
+	  SetFlag(n, "python:fastcall");
+	}
+      }
+    }
+
     if (builtin && funpack && !overname && !builtin_ctor && !GetFlag(n, "feature:compactdefaultargs")) {
       String *argattr = NewStringf("%d", tuple_arguments);
       Setattr(n, "python:argcount", argattr);
@@ -2273,11 +2343,24 @@ public:
 
     /* finish argument marshalling */
     Append(kwargs, " NULL }");
-    if (allow_kwargs) {
+    if (allow_kwargs && !fastcall_wrap) {
       Printv(f->locals, "  char *  kwnames[] = ", kwargs, ";\n", NIL);
     }
 
-    if (use_parse || allow_kwargs || !modernargs) {
+    if (fastcall_wrap) {
+      Clear(parse_args);
+      Clear(f->def);
+      Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", SWIG_FASTCALL_PARMS) {", NIL);
+      if (allow_kwargs) {
+	Printv(f->locals, "  static const char *const kwnames[] = ", kwargs, ";\n", NIL);
+	Printf(f->locals, "  static PyObject *kwcache[%d] = { 0 };\n", tuple_arguments);
+	Printf(parse_args, "if (!SWIG_Python_UnpackFastcall(\"%s\", SWIG_FASTCALL_ARGS, kwnames, kwcache, %d, %d, swig_obj)) SWIG_fail;\n", iname,
+	       num_fixed_arguments, tuple_arguments);
+      } else {
+	Printf(parse_args, "if (!SWIG_Python_UnpackFastcall(\"%s\", SWIG_FASTCALL_ARGS, 0, 0, %d, %d, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments,
+	       tuple_arguments);
+      }
+    } else if (use_parse || allow_kwargs || !modernargs) {
       if (builtin && in_class && tuple_arguments == 0) {
 	Printf(parse_args, "    if (args && PyTuple_Check(args) && PyTuple_GET_SIZE(args) > 0) SWIG_fail;\n");
       } else {
@@ -3678,7 +3761,7 @@ public:
 	  Printf(f_shadow, "(%s)", base_class);
 	} else {
 	  if (!classic) {
-	    Printf(f_shadow, modern ? "(object)" : "(_object)");
+	    Printf(f_shadow, fastthis ? "(_SwigPyProxy)" : modern ? "(object)" : "(_object)");
 	  }
 	  if (GetFlag(n, "feature:exceptionclass")) {
 	    Printf(f_shadow, "(Exception)");
@@ -3904,7 +3987,7 @@ public:
     int oldshadow;
 
     if (builtin)
-      Swig_save("builtin_memberfunc", n, "python:argcount", NIL);
+      Swig_save("builtin_memberfunc", n, "python:argcount", "python:fastcall", NIL);
 
     /* Create the default member function */
     oldshadow = shadow;		/* Disable shadowing when wrapping member functions */
@@ -3922,7 +4005,9 @@ public:
 	Setattr(class_members, symname, n);
 	int argcount = Getattr(n, "python:argcount") ? atoi(Char(Getattr(n, "python:argcount"))) : 2;
 	String *ds = have_docstring(n) ? cdocstring(n, AUTODOC_FUNC) : NewString("");
-	if (check_kwargs(n)) {
+	if (GetFlag(n, "python:fastcall")) {
+	  Printf(builtin_methods, "  { \"%s\", (PyCFunction) %s, SWIG_METH_FASTCALL, (char*) \"%s\" },\n", symname, wname, ds);
+	} else if (check_kwargs(n)) {
 	  Printf(builtin_methods, "  { \"%s\", (PyCFunction) %s, METH_VARARGS|METH_KEYWORDS, (char*) \"%s\" },\n", symname, wname, ds);
 	} else if (argcount == 0) {
 	  Printf(builtin_methods, "  { \"%s\", (PyCFunction) %s, METH_NOARGS, (char*) \"%s\" },\n", symname, wname, ds);
@@ -4023,7 +4108,9 @@ public:
 	int funpack = modernargs && fastunpack && !Getattr(n, "sym:overloaded");
 	String *pyflags = NewString("METH_STATIC|");
 	int argcount = Getattr(n, "python:argcount") ? atoi(Char(Getattr(n, "python:argcount"))) : 2;
-	if (funpack && argcount == 0)
+	if (GetFlag(n, "python:fastcall"))
+	  Append(pyflags, "SWIG_METH_FASTCALL");
+	else if (funpack && argcount == 0)
 	  Append(pyflags, "METH_NOARGS");
 	else if (funpack && argcount == 1)
 	  Append(pyflags, "METH_O");
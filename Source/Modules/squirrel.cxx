@@ -477,7 +477,11 @@ public:
     Replaceall(f->code, "$symname", iname);
     Replaceall(f->code, "$result", Swig_cresult_name());
 
-    /* Dump the function out */
+    /* Dump the function out, after a declaration of the release hook it uses */
+    if (is_constructor)
+    {
+      Printv(f_wrappers, "static SQInteger ", Swig_name_wrapper(Swig_name_destroy(getNSpace(), class_name)), "(SQUserPointer p, SQInteger size);\n", NIL);
+    }
     Wrapper_print(f, f_wrappers);
 
     /* Now register the function with the interpreter. */
@@ -855,15 +859,17 @@ public:
 
     if (have_destructor)
     {
-      Printv(f_wrappers, ", ", Swig_name_wrapper(Swig_name_destroy(getNSpace(), class_name)));
+      Printv(f_wrappers, ", ", Swig_name_wrapper(Swig_name_destroy(getNSpace(), class_name)), NIL);
     }
     else
     {
       Printf(f_wrappers, ", 0");
     }
 
-    Printf(f_wrappers, ", swig_%s_methods, swig_%s_attributes, swig_%s_bases, swig_%s_base_names, swig_%s_constants, swig_%s_nspace };\n\n",
-           mangled_classname, mangled_classname, mangled_classname, mangled_classname, mangled_classname, mangled_classname);
+    /* value types reuse their non owning wrappers, see SWIG_Squirrel_NewPointerObj() */
+    Printf(f_wrappers, ", swig_%s_methods, swig_%s_attributes, swig_%s_bases, swig_%s_base_names, swig_%s_constants, swig_%s_nspace, %d };\n\n",
+           mangled_classname, mangled_classname, mangled_classname, mangled_classname, mangled_classname, mangled_classname,
+           GetFlag(n, "feature:squirrel:valuetype") ? 1 : 0);
     /* swig_squirrel_class end */
 
     Delete(t);
@@ -967,25 +973,27 @@ public:
     {
       Printv(f_wrappers, "static SQInteger ", Swig_name_wrapper(Swig_name_destroy(NSPACE_TODO, real_classname)), "(SQUserPointer p, SQInteger size) {\n", NIL);
       if (is_extend) {
+        Printv(f_wrappers, "  ", real_classname, " *self = ", self, ";\n", NIL);
         Printv(f_wrappers, tab2, destructor_code, "\n", NIL);
       } else {
         Printv(f_wrappers, "  free(", self, ");\n", NIL);
       }
-      Printf(f_wrappers, "}\n");
+      Printf(f_wrappers, "  return 1;\n}\n");
     }
     else
     {
       Printv(f_wrappers, "static SQInteger ", Swig_name_wrapper(Swig_name_destroy(NSPACE_TODO, real_classname)), "(SQUserPointer p, SQInteger size) {\n", NIL);
       if (is_extend) {
+        Printv(f_wrappers, "  ", real_classname, " *self = ", self, ";\n", NIL);
         Printv(f_wrappers, tab2, destructor_code, "\n", NIL);
       } else {
-        Printv(f_wrappers, "#ifdef __cplusplus\n");
+        Printv(f_wrappers, "#ifdef __cplusplus\n", NIL);
         Printv(f_wrappers, "  delete ", self, ";\n", NIL);
-        Printv(f_wrappers, "#else\n");
+        Printv(f_wrappers, "#else\n", NIL);
         Printv(f_wrappers, "  free(", self, ");\n", NIL);
-        Printv(f_wrappers, "#endif\n");
+        Printv(f_wrappers, "#endif\n", NIL);
       }
-      Printf(f_wrappers, "}\n");
+      Printf(f_wrappers, "  return 1;\n}\n");
     }
 
     Delete(self);
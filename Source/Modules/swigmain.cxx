@@ -152,6 +152,8 @@ int main(int margc, char **margv) {
   int i;
   Language *dl = 0;
   ModuleFactory fac = 0;
+  const char *lang_option = 0;
+  ModuleFactory lang_fac = 0;
 
   int argc;
   char **argv;
@@ -174,11 +176,19 @@ int main(int margc, char **margv) {
   for (i = 1; i < argc; i++) {
     if (argv[i]) {
       fac = Swig_find_module(argv[i]);
-      if (fac) {
-	dl = (fac) ();
-	Swig_mark_arg(i);
-      } else if (strcmp(argv[i], "-nolang") == 0) {
-	dl = new Language;
+      if (fac || strcmp(argv[i], "-nolang") == 0) {
+	// Each language registers its own typemaps and macros while parsing, so one run cannot serve several
+	if (lang_option && fac != lang_fac) {
+	  Printf(stderr, "swig error : Only one target language can be specified, found %s and %s\n", lang_option, argv[i]);
+	  Printf(stderr, "Run SWIG once for each target language.\n");
+	  SWIG_exit(EXIT_FAILURE);
+	}
+	// Repeating the same language, eg in SWIG_FEATURES and on the command line, is fine
+	if (!lang_option) {
+	  lang_option = argv[i];
+	  lang_fac = fac;
+	  dl = fac ? (fac) () : new Language;
+	}
 	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-dnone") == 0) ||
 		 (strcmp(argv[i], "-dhtml") == 0) ||
@@ -20,6 +20,16 @@
 #include "swig.h"
 #include "preprocessor.h"
 #include <ctype.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define getcwd _getcwd
+#else
+#include <unistd.h>
+#endif
 
 static Hash *cpp = 0;		/* C preprocessor data */
 static int include_all = 0;	/* Follow all includes */
@@ -29,6 +39,11 @@ static int imported_depth = 0;	/* Depth of %imported files */
 static int single_include = 1;	/* Only include each file once */
 static Hash *included_files = 0;
 static List *dependencies = 0;
+static List *nowarn_pragmas = 0;	/* Values of #pragma SWIG nowarn=, replayed from the cache */
+static String *cache_dir = 0;	/* Preprocessor cache directory, see Preprocessor_cache_parse() */
+static String *cache_options = 0;
+static Hash *cache_volatile = 0;	/* Macros whose value is not part of the cache key */
+static int cache_volatile_expanded = 0;
 static Scanner *id_scan = 0;
 static int error_as_warning = 0;	/* Understand the cpp #error directive as a special #warning */
 static int expand_defined_operator = 0;
@@ -246,6 +261,10 @@ void Preprocessor_delete(void) {
   DelScanner(id_scan);
 
   Delete(dependencies);
+  Delete(nowarn_pragmas);
+  Delete(cache_dir);
+  Delete(cache_options);
+  Delete(cache_volatile);
 
   Delete(Swig_add_directory(0));
 }
@@ -745,6 +764,8 @@ static String *expand_macro(String *name, List *args, String *line_file) {
   macro = Getattr(symbols, name);
   if (!macro)
     return 0;
+  if (cache_volatile && Getattr(cache_volatile, name))
+    cache_volatile_expanded = 1;
 
   if (macro_level == 0) {
     /* Store the start of the macro should the macro contain __LINE__ and __FILE__ for expansion */
@@ -1757,6 +1778,9 @@ String *Preprocessor_parse(String *s) {
 	      String *val = NewString(c + 7);
 	      String *nowarn = Preprocessor_replace(val);
 	      Swig_warnfilter(nowarn, 1);
+	      if (!nowarn_pragmas)
+		nowarn_pragmas = NewList();
+	      Append(nowarn_pragmas, nowarn);
 	      Delete(nowarn);
 	      Delete(val);
 	    } else if (strncmp(c, "cpperraswarn=", 13) == 0) {
@@ -2033,3 +2057,473 @@ String *Preprocessor_parse(String *s) {
 
   return ns;
 }
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor cache
+ *
+ * When a cache directory has been set, the output of a top level
+ * Preprocessor_parse() is saved so that an identical later run can skip
+ * preprocessing altogether.  An entry is keyed on the SWIG version, the
+ * options passed to Preprocessor_cache_dir() (the command line), the current
+ * directory, the resolved search path and the text being preprocessed.  The
+ * entry also lists every file
+ * that was included together with its size and a digest of its contents, so
+ * editing any of them invalidates the entry.  It also lists the files that
+ * were looked for and not found, such as the same name in the search
+ * directories before the one an included file was found in, so creating any
+ * of them invalidates the entry too.  Only runs that issue no warnings or
+ * errors are cached, as the diagnostics would not be repeated.  Nor are runs
+ * that expand any of the macros passed to Preprocessor_cache_volatile().
+ * The macros defined at the end of preprocessing are stored too, as the
+ * parser preprocesses %inline code later on.
+ *
+ * An entry file has the following layout, where <n> is a byte count or
+ * number of lines:
+ *
+ *     %swigcache <version>
+ *     <n>
+ *     <key text>
+ *     depend <n>
+ *     <size> <digest> <filename>
+ *     missing <n>
+ *     <filename>
+ *     nowarn <n>
+ *     <warning list>
+ *     macros <n>
+ *     <name>
+ *     <filename>
+ *     <line> <value line> <number of args or -1> <swigmacro> <varargs>
+ *     <arg>
+ *     <n>
+ *     <value>
+ *     <n>
+ *     <preprocessed output>
+ * ----------------------------------------------------------------------------- */
+
+/* Two independent 32 bit hashes (FNV-1a and a murmur style mix) as 16 hex digits */
+static void cache_digest(const char *data, int len, char *hex) {
+  unsigned int h1 = 2166136261U;
+  unsigned int h2 = 0x9747b28cU;
+  int i;
+  for (i = 0; i < len; i++) {
+    unsigned int c = (unsigned char) data[i];
+    h1 = ((h1 ^ c) * 16777619U) & 0xffffffffU;
+    h2 = ((h2 ^ c) * 0x5bd1e995U) & 0xffffffffU;
+    h2 ^= h2 >> 15;
+  }
+  sprintf(hex, "%08x%08x", h1, h2);
+}
+
+/* Returns "<size> <digest>" for a file, or 0 if it cannot be read */
+static String *cache_file_digest(String *filename) {
+  char hex[17];
+  String *str;
+  String *result;
+  FILE *f = fopen(Char(filename), "r");
+  if (!f)
+    return 0;
+  str = Swig_read_file(f);
+  fclose(f);
+  cache_digest(Char(str), Len(str), hex);
+  result = NewStringf("%d %s", Len(str), hex);
+  Delete(str);
+  return result;
+}
+
+static String *cache_key(String *s) {
+  char cwd[4096];
+  String *key = NewStringf("%s\n", Swig_package_version());
+  List *dirs = Swig_search_path();
+  int i;
+  if (cache_options)
+    Printf(key, "%s\n", cache_options);
+  if (getcwd(cwd, sizeof(cwd)))
+    Printf(key, "%s\n", cwd);
+  for (i = 0; i < Len(dirs); i++)
+    Printf(key, "%s\n", Getitem(dirs, i));
+  Delete(dirs);
+  Append(key, s);
+  return key;
+}
+
+static String *cache_filename(String *key) {
+  char hex[17];
+  cache_digest(Char(key), Len(key), hex);
+  return NewStringf("%s%s%s.swigcpp", cache_dir, SWIG_FILE_DELIMITER, hex);
+}
+
+/* Reads up to the next newline into line, returns 0 if there is none */
+static const char *cache_getline(const char *c, const char *end, String *line) {
+  const char *nl = c;
+  while (nl < end && *nl != '\n')
+    nl++;
+  if (nl == end)
+    return 0;
+  Clear(line);
+  Write(line, c, (int) (nl - c));
+  return nl + 1;
+}
+
+/* Reads a "<n>\n<n bytes>\n" block into block, returns 0 if malformed */
+static const char *cache_getblock(const char *c, const char *end, String *line, String *block) {
+  int len;
+  c = cache_getline(c, end, line);
+  if (!c)
+    return 0;
+  len = atoi(Char(line));
+  if (len < 0 || len > (int) (end - c) - 1 || c[len] != '\n')
+    return 0;
+  Clear(block);
+  Write(block, c, len);
+  return c + len + 1;
+}
+
+/* Appends a macro to a cache entry, returns 0 if it cannot be stored */
+static int cache_putmacro(String *entry, Hash *macro) {
+  String *name = Getattr(macro, kpp_name);
+  String *file = Getfile(macro);
+  String *value = Getattr(macro, kpp_value);
+  List *args = Getattr(macro, kpp_args);
+  int i;
+  if (Strchr(name, '\n') || (file && Strchr(file, '\n')))
+    return 0;
+  Printf(entry, "%s\n%s\n%d %d %d %d %d\n", name, file ? file : "", Getline(macro), Getline(value), args ? Len(args) : -1,
+	 Getattr(macro, kpp_swigmacro) ? 1 : 0, Getattr(macro, kpp_varargs) ? 1 : 0);
+  for (i = 0; args && i < Len(args); i++) {
+    if (Strchr(Getitem(args, i), '\n'))
+      return 0;
+    Printf(entry, "%s\n", Getitem(args, i));
+  }
+  Printf(entry, "%d\n%s\n", Len(value), value);
+  return 1;
+}
+
+/* Reads a macro written by cache_putmacro() into symbols, returns 0 if malformed */
+static const char *cache_getmacro(const char *c, const char *end, String *line, String *block, Hash *symbols) {
+  Hash *macro;
+  String *name;
+  String *file;
+  String *value;
+  int mline, vline, nargs, swigmacro, varargs;
+  int i;
+  if (!(c = cache_getline(c, end, line)))
+    return 0;
+  name = Copy(line);
+  if (!(c = cache_getline(c, end, line))) {
+    Delete(name);
+    return 0;
+  }
+  file = Copy(line);
+  macro = NewHash();
+  if (!(c = cache_getline(c, end, line)) || sscanf(Char(line), "%d %d %d %d %d", &mline, &vline, &nargs, &swigmacro, &varargs) != 5)
+    goto fail;
+  if (nargs >= 0) {
+    List *args = NewList();
+    Setattr(macro, kpp_args, args);
+    Delete(args);
+    for (i = 0; i < nargs; i++) {
+      String *arg;
+      if (!(c = cache_getline(c, end, line)))
+	goto fail;
+      arg = Copy(line);
+      Append(args, arg);
+      Delete(arg);
+    }
+    if (varargs)
+      Setattr(macro, kpp_varargs, "1");
+  }
+  if (!(c = cache_getblock(c, end, line, block)))
+    goto fail;
+  value = Copy(block);
+  if (Len(file)) {
+    Setfile(name, file);
+    Setfile(value, file);
+    Setfile(macro, file);
+  }
+  Setline(name, mline);
+  Setline(value, vline);
+  Setline(macro, mline);
+  Setattr(macro, kpp_name, name);
+  Setattr(macro, kpp_value, value);
+  if (swigmacro)
+    Setattr(macro, kpp_swigmacro, "1");
+  Setattr(symbols, name, macro);
+  Delete(value);
+  Delete(macro);
+  Delete(file);
+  Delete(name);
+  return c;
+
+fail:
+  Delete(macro);
+  Delete(file);
+  Delete(name);
+  return 0;
+}
+
+static String *cache_lookup(String *key, String *filename) {
+  String *result = 0;
+  String *data;
+  String *line;
+  String *block;
+  String *header;
+  List *depend;
+  List *nowarn;
+  Hash *checked;
+  Hash *symbols;
+  const char *c;
+  const char *end;
+  int i, n;
+  FILE *f = fopen(Char(filename), "r");
+  if (!f)
+    return 0;
+  data = Swig_read_file(f);
+  fclose(f);
+
+  line = NewStringEmpty();
+  block = NewStringEmpty();
+  header = NewStringf("%%swigcache %s", Swig_package_version());
+  depend = NewList();
+  nowarn = NewList();
+  checked = NewHash();
+  symbols = NewHash();
+  c = Char(data);
+  end = c + Len(data);
+
+  if (!(c = cache_getline(c, end, line)) || !Equal(line, header))
+    goto done;
+  if (!(c = cache_getblock(c, end, line, block)) || !Equal(block, key))
+    goto done;
+
+  if (!(c = cache_getline(c, end, line)) || Strncmp(line, "depend ", 7) != 0)
+    goto done;
+  n = atoi(Char(line) + 7);
+  for (i = 0; i < n; i++) {
+    String *file;
+    String *digest;
+    char *sep;
+    if (!(c = cache_getline(c, end, line)))
+      goto done;
+    /* "<size> <digest> <filename>" - the filename is everything after the second space */
+    sep = strchr(Char(line), ' ');
+    sep = sep ? strchr(sep + 1, ' ') : 0;
+    if (!sep)
+      goto done;
+    file = NewString(sep + 1);
+    if (!Getattr(checked, file)) {
+      int same;
+      digest = cache_file_digest(file);
+      same = digest && Len(digest) == (int) (sep - Char(line)) && Strncmp(line, digest, Len(digest)) == 0;
+      Delete(digest);
+      if (!same) {
+	Delete(file);
+	goto done;
+      }
+      Setattr(checked, file, "1");
+    }
+    Append(depend, file);
+    Delete(file);
+  }
+
+  if (!(c = cache_getline(c, end, line)) || Strncmp(line, "missing ", 8) != 0)
+    goto done;
+  n = atoi(Char(line) + 8);
+  for (i = 0; i < n; i++) {
+    FILE *mf;
+    if (!(c = cache_getline(c, end, line)))
+      goto done;
+    mf = fopen(Char(line), "r");
+    if (mf) {
+      fclose(mf);
+      goto done;
+    }
+  }
+
+  if (!(c = cache_getline(c, end, line)) || Strncmp(line, "nowarn ", 7) != 0)
+    goto done;
+  n = atoi(Char(line) + 7);
+  for (i = 0; i < n; i++) {
+    if (!(c = cache_getline(c, end, line)))
+      goto done;
+    Append(nowarn, line);
+  }
+
+  if (!(c = cache_getline(c, end, line)) || Strncmp(line, "macros ", 7) != 0)
+    goto done;
+  n = atoi(Char(line) + 7);
+  for (i = 0; i < n; i++) {
+    if (!(c = cache_getmacro(c, end, line, block, symbols)))
+      goto done;
+  }
+
+  if (!(c = cache_getblock(c, end, line, block)))
+    goto done;
+
+  /* A complete and valid entry, restore the side effects of preprocessing */
+  if (!dependencies)
+    dependencies = NewList();
+  for (i = 0; i < Len(depend); i++)
+    Append(dependencies, Getitem(depend, i));
+  for (i = 0; i < Len(nowarn); i++)
+    Swig_warnfilter(Getitem(nowarn, i), 1);
+  Setattr(cpp, kpp_symbols, symbols);
+  result = Copy(block);
+
+done:
+  Delete(symbols);
+  Delete(checked);
+  Delete(nowarn);
+  Delete(depend);
+  Delete(header);
+  Delete(block);
+  Delete(line);
+  Delete(data);
+  return result;
+}
+
+static void cache_store(String *key, String *filename, String *output, List *missed) {
+  String *entry;
+  String *tmpname;
+  Hash *digests;
+  Hash *missing;
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  Iterator ki;
+  FILE *f;
+  int i;
+  int ndepend = dependencies ? Len(dependencies) : 0;
+  int nnowarn = nowarn_pragmas ? Len(nowarn_pragmas) : 0;
+
+  entry = NewStringf("%%swigcache %s\n%d\n%s\ndepend %d\n", Swig_package_version(), Len(key), key, ndepend);
+  digests = NewHash();
+  missing = NewHash();
+  for (i = 0; i < ndepend; i++) {
+    String *file = Getitem(dependencies, i);
+    String *digest = Getattr(digests, file);
+    if (!digest) {
+      digest = cache_file_digest(file);
+      if (!digest || Strchr(file, '\n')) {
+	Delete(digest);
+	goto done;
+      }
+      Setattr(digests, file, digest);
+      Delete(digest);
+    }
+    Printf(entry, "%s %s\n", digest, file);
+  }
+  for (i = 0; i < Len(missed); i++) {
+    String *file = Getitem(missed, i);
+    if (Strchr(file, '\n'))
+      goto done;
+    Setattr(missing, file, "1");
+  }
+  Printf(entry, "missing %d\n", Len(missing));
+  for (i = 0; i < Len(missed); i++) {
+    String *file = Getitem(missed, i);
+    if (Getattr(missing, file)) {
+      Printf(entry, "%s\n", file);
+      Delattr(missing, file);
+    }
+  }
+  Printf(entry, "nowarn %d\n", nnowarn);
+  for (i = 0; i < nnowarn; i++)
+    Printf(entry, "%s\n", Getitem(nowarn_pragmas, i));
+  Printf(entry, "macros %d\n", Len(symbols));
+  for (ki = First(symbols); ki.key; ki = Next(ki)) {
+    if (!cache_putmacro(entry, ki.item))
+      goto done;
+  }
+  Printf(entry, "%d\n%s\n", Len(output), output);
+
+  /* Write to a temporary file and rename it so other processes never see a partial entry */
+  tmpname = NewStringf("%s.tmp", filename);
+  f = fopen(Char(tmpname), "w");
+  if (!f) {
+#ifdef _WIN32
+    _mkdir(Char(cache_dir));
+#else
+    mkdir(Char(cache_dir), 0777);
+#endif
+    f = fopen(Char(tmpname), "w");
+  }
+  if (f) {
+    int ok = fwrite(Char(entry), 1, Len(entry), f) == (size_t) Len(entry);
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(Char(tmpname), Char(filename)) != 0)
+      remove(Char(tmpname));
+  }
+  Delete(tmpname);
+
+done:
+  Delete(missing);
+  Delete(digests);
+  Delete(entry);
+}
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor_cache_dir()
+ *
+ * Enable the preprocessor cache in directory dir, which is created if needed.
+ * options should describe everything outside of the preprocessed files that
+ * can influence the output, typically the complete command line.
+ * ----------------------------------------------------------------------------- */
+
+void Preprocessor_cache_dir(const_String_or_char_ptr dir, const_String_or_char_ptr options) {
+  Delete(cache_dir);
+  Delete(cache_options);
+  cache_dir = dir ? NewString(dir) : 0;
+  cache_options = options ? NewString(options) : 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor_cache_volatile()
+ *
+ * Tell the cache that the value of macro name has been left out of the
+ * options, typically because it names an output file.  The output of a run
+ * which expands the macro is not cached.
+ * ----------------------------------------------------------------------------- */
+
+void Preprocessor_cache_volatile(const_String_or_char_ptr name) {
+  if (!cache_volatile)
+    cache_volatile = NewHash();
+  Setattr(cache_volatile, name, "1");
+}
+
+/* -----------------------------------------------------------------------------
+ * Preprocessor_cache_parse()
+ *
+ * Same as Preprocessor_parse(), but reuses the output from the cache directory
+ * when none of the inputs have changed since it was stored.
+ * ----------------------------------------------------------------------------- */
+
+String *Preprocessor_cache_parse(String *s) {
+  String *key;
+  String *filename;
+  String *ns;
+  List *missed;
+  int nwarnings;
+  int nerrors;
+
+  if (!cache_dir)
+    return Preprocessor_parse(s);
+
+  key = cache_key(s);
+  filename = cache_filename(key);
+  ns = cache_lookup(key, filename);
+  if (ns) {
+    copy_location(s, ns);
+  } else {
+    nwarnings = Swig_warn_count();
+    nerrors = Swig_error_count();
+    missed = NewList();
+    cache_volatile_expanded = 0;
+    Swig_set_missed_files(missed);
+    ns = Preprocessor_parse(s);
+    Swig_set_missed_files(0);
+    if (Swig_warn_count() == nwarnings && Swig_error_count() == nerrors && !cache_volatile_expanded)
+      cache_store(key, filename, ns, missed);
+    Delete(missed);
+  }
+  Delete(filename);
+  Delete(key);
+  return ns;
+}
@@ -31,6 +31,9 @@ extern "C" {
   extern void Preprocessor_ignore_missing(int);
   extern void Preprocessor_error_as_warning(int);
   extern List *Preprocessor_depend(void);
+  extern void Preprocessor_cache_dir(const_String_or_char_ptr dir, const_String_or_char_ptr options);
+  extern void Preprocessor_cache_volatile(const_String_or_char_ptr name);
+  extern String *Preprocessor_cache_parse(String *s);
   extern void Preprocessor_expr_init(void);
   extern void Preprocessor_expr_delete(void);
 
@@ -14,11 +14,14 @@
  * ----------------------------------------------------------------------------- */
 
 #include "swig.h"
+#include <limits.h>
 
 static List   *directories = 0;	        /* List of include directories */
 static String *lastpath = 0;	        /* Last file that was included */
 static List   *pdirectories = 0;        /* List of pushed directories  */
 static int     dopush = 1;		/* Whether to push directories */
+static Hash   *found_files = 0;		/* Cache of include path searches */
+static List   *missed_files = 0;	/* Files looked for and not found, see Swig_set_missed_files() */
 static int file_debug = 0;
 
 /* This functions determine whether to push/pop dirs in the preprocessor */
@@ -45,6 +48,8 @@ List *Swig_add_directory(const_String_or_char_ptr dirname) {
     adirname = NewString(dirname);
     Append(directories,adirname);
     Delete(adirname);
+    if (found_files)
+      Clear(found_files);
   }
   return directories;
 }
@@ -95,6 +100,18 @@ String *Swig_last_file(void) {
   return lastpath;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_set_missed_files()
+ * 
+ * Appends the name of every file that is looked for and not found to missed,
+ * or stops doing so if missed is 0.  This records how each file was found, as
+ * creating any of the missed files would change which file is opened.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_set_missed_files(List *missed) {
+  missed_files = missed;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_search_path_any() 
  * 
@@ -161,6 +178,8 @@ List *Swig_search_path() {
 static FILE *Swig_open_file(const_String_or_char_ptr name, int sysfile, int use_include_path) {
   FILE *f;
   String *filename;
+  String *key = 0;
+  List *found = 0;
   List *spath = 0;
   char *cname;
   int i, ilen;
@@ -176,7 +195,46 @@ static FILE *Swig_open_file(const_String_or_char_ptr name, int sysfile, int use_
     Printf(stdout, "  Open: %s\n", filename);
   }
   f = fopen(Char(filename), "r");
+  if (!f && missed_files)
+    Append(missed_files, cname);
   if (!f && use_include_path) {
+    /* The search path only changes when a directory is added or pushed, so
+       the result of a search is cached for the name and the pushed directories,
+       including the failures.  Each result is a list of the file found, or ""
+       if there is none, followed by the files tried before it.  The cached file
+       is still opened in case it has been removed since. */
+    if (!found_files)
+      found_files = NewHash();
+    key = NewStringf("%d%s", sysfile, cname);
+    if (pdirectories) {
+      ilen = Len(pdirectories);
+      for (i = 0; i < ilen; i++) {
+	Printf(key, "\n%s", Getitem(pdirectories, i));
+      }
+    }
+    found = Getattr(found_files, key);
+    if (found) {
+      String *path = Getitem(found, 0);
+      if (Len(path)) {
+	Clear(filename);
+	Append(filename, path);
+	f = fopen(Char(filename), "r");
+      }
+      if (f || !Len(path)) {
+	if (missed_files) {
+	  ilen = Len(found);
+	  for (i = 1; i < ilen; i++) {
+	    Append(missed_files, Getitem(found, i));
+	  }
+	}
+	Delete(key);
+	key = 0;
+      }
+    }
+  }
+  if (key) {
+    found = NewList();
+    Append(found, "");
     spath = Swig_search_path_any(sysfile);
     ilen = Len(spath);
     for (i = 0; i < ilen; i++) {
@@ -185,12 +243,22 @@ static FILE *Swig_open_file(const_String_or_char_ptr name, int sysfile, int use_
       f = fopen(Char(filename), "r");
       if (f)
 	break;
+      Append(found, Char(filename));
+      if (missed_files)
+	Append(missed_files, Char(filename));
     }
     Delete(spath);
+    if (f)
+      Setitem(found, 0, Char(filename));
+    Setattr(found_files, key, found);
+    Delete(found);
+    Delete(key);
   }
   if (f) {
     Delete(lastpath);
     lastpath = filename;
+  } else {
+    Delete(filename);
   }
   return f;
 }
@@ -210,28 +278,42 @@ FILE *Swig_open(const_String_or_char_ptr name) {
 /* -----------------------------------------------------------------------------
  * Swig_read_file()
  * 
- * Reads data from an open FILE * and returns it as a string.
+ * Reads data from an open FILE * and returns it as a string.  The file is
+ * read into a buffer sized from its length, usually with a single fread(),
+ * and the buffer becomes the string's data.
  * ----------------------------------------------------------------------------- */
 
 String *Swig_read_file(FILE *f) {
-  int len;
-  char buffer[4096];
-  String *str = NewStringEmpty();
-
-  assert(str);
-  while (fgets(buffer, 4095, f)) {
-    Append(str, buffer);
+  int len = 0;
+  int size = 4096;
+  size_t n;
+  long pos;
+  long end;
+  char *buffer;
+
+  /* The size is only a hint, text mode translation may read less */
+  pos = ftell(f);
+  if (pos >= 0 && fseek(f, 0, SEEK_END) == 0) {
+    end = ftell(f);
+    if (fseek(f, pos, SEEK_SET) == 0 && end > pos && end - pos < INT_MAX - 2)
+      size = (int) (end - pos) + 1;
+  }
+  buffer = (char *) DohMalloc(size + 2);
+  assert(buffer);
+  while ((n = fread(buffer + len, 1, size - len, f)) > 0) {
+    len += (int) n;
+    if (len == size) {
+      size *= 2;
+      buffer = (char *) DohRealloc(buffer, size + 2);
+      assert(buffer);
+    }
   }
-  len = Len(str);
   /* Add a newline if not present on last line -- the preprocessor seems to 
    * rely on \n and not EOF terminating lines */
-  if (len) {
-    char *cstr = Char(str);
-    if (cstr[len - 1] != '\n') {
-      Append(str, "\n");
-    }
+  if (len && buffer[len - 1] != '\n') {
+    buffer[len++] = '\n';
   }
-  return str;
+  return NewStringAdopt(buffer, len);
 }
 
 /* -----------------------------------------------------------------------------
@@ -1172,6 +1172,33 @@ String *replace_captures(int num_captures, const char *input, String *subst, int
   return result;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_regex_compile()
+ *
+ * Returns the compiled form of a regular expression pattern, as a DOH Void
+ * which owns it.  Patterns are compiled once and cached, as the same
+ * %(regex:...)s rename is typically applied to every declaration.  Returns
+ * NULL and sets *error and *errorpos if the pattern does not compile.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *regex_cache = 0;
+
+DOH *Swig_regex_compile(String *pattern, const char **error, int *errorpos) {
+  DOH *compiled;
+  if (!regex_cache)
+    regex_cache = NewHash();
+  compiled = Getattr(regex_cache, pattern);
+  if (!compiled) {
+    pcre *compiled_pat = pcre_compile(Char(pattern), 0, error, errorpos, NULL);
+    if (!compiled_pat)
+      return 0;
+    compiled = NewVoid(compiled_pat, pcre_free);
+    Setattr(regex_cache, pattern, compiled);
+    Delete(compiled);
+  }
+  return compiled;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_string_regex()
  *
@@ -1180,10 +1207,8 @@ String *replace_captures(int num_captures, const char *input, String *subst, int
  *   Printf(stderr,"gsl%(regex:/GSL_.*_/\\1/)s","GSL_Hello_") -> gslHello
  * ----------------------------------------------------------------------------- */
 String *Swig_string_regex(String *s) {
-  const int pcre_options = 0;
-
   String *res = 0;
-  pcre *compiled_pat = 0;
+  DOH *compiled_pat = 0;
   const char *pcre_error, *input;
   int pcre_errorpos;
   String *pattern = 0, *subst = 0;
@@ -1192,14 +1217,13 @@ String *Swig_string_regex(String *s) {
   if (split_regex_pattern_subst(s, &pattern, &subst, &input)) {
     int rc;
 
-    compiled_pat = pcre_compile(
-          Char(pattern), pcre_options, &pcre_error, &pcre_errorpos, NULL);
+    compiled_pat = Swig_regex_compile(pattern, &pcre_error, &pcre_errorpos);
     if (!compiled_pat) {
       Swig_error("SWIG", Getline(s), "PCRE compilation failed: '%s' in '%s':%i.\n",
           pcre_error, Char(pattern), pcre_errorpos);
       exit(1);
     }
-    rc = pcre_exec(compiled_pat, NULL, input, strlen(input), 0, 0, captures, 30);
+    rc = pcre_exec((pcre *)Data(compiled_pat), NULL, input, strlen(input), 0, 0, captures, 30);
     if (rc >= 0) {
       res = replace_captures(rc, input, subst, captures, pattern, s);
     } else if (rc != PCRE_ERROR_NOMATCH) {
@@ -1211,7 +1235,6 @@ String *Swig_string_regex(String *s) {
 
   DohDelete(pattern);
   DohDelete(subst);
-  pcre_free(compiled_pat);
   return res ? res : NewStringEmpty();
 }
 
@@ -1221,6 +1244,13 @@ String *Swig_pcre_version(void) {
 
 #else
 
+DOH *Swig_regex_compile(String *pattern, const char **error, int *errorpos) {
+  (void)pattern;
+  *error = "PCRE regex support not enabled in this SWIG build";
+  *errorpos = 0;
+  return 0;
+}
+
 String *Swig_string_regex(String *s) {
   Swig_error("SWIG", Getline(s), "PCRE regex support not enabled in this SWIG build.\n");
   exit(1);
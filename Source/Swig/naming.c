@@ -555,6 +555,97 @@ DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType
   return rn;
 }
 
+/* -----------------------------------------------------------------------------
+ * Feature lookup cache
+ *
+ * Swig_features_get() is called for every declaration, often more than once,
+ * and each call looks up several names in the features hash and merges what
+ * it finds into the node.  The features found for a given prefix, name and
+ * decl are kept in features_cache as a list of alternating feature names and
+ * values, in the order they are first set on the node.
+ *
+ * All the names looked up for a declaration are either "", the class prefix
+ * followed by "::", or end in the declaration name, possibly with its
+ * template parameters removed.  So features_cache_index maps "p:<prefix>"
+ * and "n:<base name>" to the cache keys using them and Swig_feature_set() or
+ * Swig_name_object_inherit() only throw away the entries which could now
+ * find something different.  Only the features hash most recently passed to
+ * Swig_features_get() is cached.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *features_cache = 0;
+static Hash *features_cache_index = 0;
+static Hash *features_cache_owner = 0;
+static int features_cache_hits = 0;
+static int features_cache_misses = 0;
+static int features_cache_invalidated = 0;
+
+/* The index name for a feature name or declaration name */
+static String *features_cache_index_name(const_String_or_char_ptr name) {
+  String *last = Swig_scopename_last(name);
+  String *base = SwigType_templateprefix(last);
+  String *iname = NewStringf("n:%s", base);
+  Delete(base);
+  Delete(last);
+  return iname;
+}
+
+static void features_cache_index_add(String *iname, String *key) {
+  List *keys = Getattr(features_cache_index, iname);
+  if (!keys) {
+    keys = NewList();
+    Setattr(features_cache_index, iname, keys);
+    Delete(keys);
+  }
+  Append(keys, key);
+}
+
+static void features_cache_invalidate(Hash *features, const_String_or_char_ptr tname) {
+  String *iname;
+  List *keys;
+  int len;
+  if (features != features_cache_owner || !features_cache_index)
+    return;
+  len = Len(tname);
+  if (len == 0) {
+    /* A global feature applies to every declaration */
+    features_cache_invalidated += Len(features_cache);
+    Clear(features_cache);
+    Clear(features_cache_index);
+    return;
+  }
+  if (len > 2 && strcmp(Char(tname) + len - 2, "::") == 0) {
+    iname = NewStringf("p:%s", tname);
+    Delslice(iname, Len(iname) - 2, DOH_END);
+  } else {
+    iname = features_cache_index_name(tname);
+  }
+  keys = Getattr(features_cache_index, iname);
+  if (keys) {
+    Iterator i;
+    for (i = First(keys); i.item; i = Next(i)) {
+      if (Getattr(features_cache, i.item)) {
+	Delattr(features_cache, i.item);
+	features_cache_invalidated++;
+      }
+    }
+    Delattr(features_cache_index, iname);
+  }
+  Delete(iname);
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_features_debug_stats()
+ *
+ * Display feature lookup cache statistics
+ * ----------------------------------------------------------------------------- */
+
+void Swig_features_debug_stats(void) {
+  int total = features_cache_hits + features_cache_misses;
+  Printf(stdout, "Feature lookup cache: %d lookups, %d hits, %d misses (%.1f%% hit rate), %d entries invalidated\n",
+	 total, features_cache_hits, features_cache_misses, total ? 100.0 * features_cache_hits / total : 0.0, features_cache_invalidated);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_name_object_inherit()
  *
@@ -589,6 +680,7 @@ void Swig_name_object_inherit(Hash *namehash, String *base, String *derived) {
       Hash *newh;
 
       /* Don't overwrite an existing value for the derived class, if any. */
+      features_cache_invalidate(namehash, nkey);
       newh = Getattr(namehash, nkey);
       if (!newh) {
 	if (!derh)
@@ -624,18 +716,20 @@ void Swig_name_object_inherit(Hash *namehash, String *base, String *derived) {
 /* -----------------------------------------------------------------------------
  * merge_features()
  *
- * Given a hash, this function merges the features in the hash into the node.
+ * Given a hash, this function adds the features in the hash to resolved,
+ * a hash of the features found so far.  Feature names are appended to order
+ * when first found.
  * ----------------------------------------------------------------------------- */
 
-static void merge_features(Hash *features, Node *n) {
+static void merge_features(Hash *features, Hash *resolved, List *order) {
   Iterator ki;
 
   if (!features)
     return;
   for (ki = First(features); ki.key; ki = Next(ki)) {
-    String *ci = Copy(ki.item);
-    Setattr(n, ki.key, ci);
-    Delete(ci);
+    if (!Getattr(resolved, ki.key))
+      Append(order, ki.key);
+    Setattr(resolved, ki.key, ki.item);
   }
 }
 
@@ -647,25 +741,34 @@ static void merge_features(Hash *features, Node *n) {
  * ----------------------------------------------------------------------------- */
 
 static
-void features_get(Hash *features, const String *tname, SwigType *decl, SwigType *ncdecl, Node *node) {
+void features_get(Hash *features, const String *tname, SwigType *decl, SwigType *ncdecl, Hash *resolved, List *order) {
   Node *n = Getattr(features, tname);
 #ifdef SWIG_DEBUG
   Printf(stdout, "  features_get: %s\n", tname);
 #endif
   if (n) {
-    merge_features(get_object(n, 0), node);
+    merge_features(get_object(n, 0), resolved, order);
     if (ncdecl)
-      merge_features(get_object(n, ncdecl), node);
-    merge_features(get_object(n, decl), node);
+      merge_features(get_object(n, ncdecl), resolved, order);
+    merge_features(get_object(n, decl), resolved, order);
   }
 }
 
-void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
+/* -----------------------------------------------------------------------------
+ * features_resolve()
+ *
+ * Returns the list of alternating feature names and values for the
+ * declaration, in the order they are to be set on the node.
+ * ----------------------------------------------------------------------------- */
+
+static List *features_resolve(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
   char *ncdecl = 0;
   String *rdecl = 0;
   String *rname = 0;
-  if (!features)
-    return;
+  Hash *resolved = NewHash();
+  List *order = NewList();
+  List *result;
+  Iterator oi;
 
   /* MM: This removed to more tightly control feature/name matching */
   /*
@@ -706,27 +809,27 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
 #endif
 
   /* Global features */
-  features_get(features, "", 0, 0, node);
+  features_get(features, "", 0, 0, resolved, order);
   if (name) {
     String *tname = NewStringEmpty();
     /* add features for 'root' template */
     String *dname = SwigType_istemplate_templateprefix(name);
     if (dname) {
-      features_get(features, dname, decl, ncdecl, node);
+      features_get(features, dname, decl, ncdecl, resolved, order);
     }
     /* Catch-all */
-    features_get(features, name, decl, ncdecl, node);
+    features_get(features, name, decl, ncdecl, resolved, order);
     /* Perform a class-based lookup (if class prefix supplied) */
     if (prefix) {
       /* A class-generic feature */
       if (Len(prefix)) {
 	Printf(tname, "%s::", prefix);
-	features_get(features, tname, decl, ncdecl, node);
+	features_get(features, tname, decl, ncdecl, resolved, order);
       }
       /* A wildcard-based class lookup */
       Clear(tname);
       Printf(tname, "*::%s", name);
-      features_get(features, tname, decl, ncdecl, node);
+      features_get(features, tname, decl, ncdecl, resolved, order);
       /* A specific class lookup */
       if (Len(prefix)) {
 	/* A template-based class lookup */
@@ -734,22 +837,87 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
 	if (tprefix) {
 	  Clear(tname);
 	  Printf(tname, "%s::%s", tprefix, name);
-	  features_get(features, tname, decl, ncdecl, node);
+	  features_get(features, tname, decl, ncdecl, resolved, order);
 	}
 	Clear(tname);
 	Printf(tname, "%s::%s", prefix, name);
-	features_get(features, tname, decl, ncdecl, node);
+	features_get(features, tname, decl, ncdecl, resolved, order);
 	Delete(tprefix);
       }
     } else {
       /* Lookup in the global namespace only */
       Clear(tname);
       Printf(tname, "::%s", name);
-      features_get(features, tname, decl, ncdecl, node);
+      features_get(features, tname, decl, ncdecl, resolved, order);
     }
     Delete(tname);
     Delete(dname);
   }
+  if (rname)
+    Delete(rname);
+  if (rdecl)
+    Delete(rdecl);
+
+  result = NewList();
+  for (oi = First(order); oi.item; oi = Next(oi)) {
+    Append(result, oi.item);
+    Append(result, Getattr(resolved, oi.item));
+  }
+  Delete(order);
+  Delete(resolved);
+  return result;
+}
+
+void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
+  String *key;
+  List *found;
+  int i, len;
+  int ctor = 0;
+  if (!features)
+    return;
+
+  if (features != features_cache_owner) {
+    Delete(features_cache);
+    Delete(features_cache_index);
+    features_cache = NewHash();
+    features_cache_index = NewHash();
+    features_cache_owner = features;
+  }
+
+  /* The template constructor/destructor name rewrite in features_resolve() depends on the node type */
+  if (name && SwigType_istemplate(name)) {
+    String *nodetype = nodeType(node);
+    ctor = nodetype && (Equal(nodetype, "constructor") || Equal(nodetype, "destructor"));
+  }
+  key = NewStringf("%s\t%s\t%s\t%d", prefix ? prefix : "\001", name ? name : "\001", decl ? decl : "\001", ctor);
+  found = Getattr(features_cache, key);
+  if (found) {
+    features_cache_hits++;
+  } else {
+    features_cache_misses++;
+    found = features_resolve(features, prefix, name, decl, node);
+    Setattr(features_cache, key, found);
+    if (name) {
+      String *iname = features_cache_index_name(name);
+      features_cache_index_add(iname, key);
+      Delete(iname);
+    }
+    if (prefix && Len(prefix)) {
+      String *iname = NewStringf("p:%s", prefix);
+      features_cache_index_add(iname, key);
+      Delete(iname);
+    }
+    Delete(found);
+  }
+  Delete(key);
+
+  len = Len(found);
+  for (i = 0; i < len; i += 2) {
+    String *ci = Copy(Getitem(found, i + 1));
+    Setattr(node, Getitem(found, i), ci);
+    Delete(ci);
+  }
+
   if (name && SwigType_istemplate(name)) {
     /* add features for complete template type */
     String *dname = Swig_symbol_template_deftype(name, 0);
@@ -758,14 +926,10 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
     }
     Delete(dname);
   }
-
-  if (rname)
-    Delete(rname);
-  if (rdecl)
-    Delete(rdecl);
 }
 
 
+
 /* -----------------------------------------------------------------------------
  * Swig_feature_set()
  *
@@ -810,6 +974,7 @@ void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *d
   } else {
     Delattr(fhash, featurename);
   }
+  features_cache_invalidate(features, name);
 
   {
     /* Add in the optional feature attributes */
@@ -857,17 +1022,46 @@ Hash *Swig_name_rename_hash() {
   return rename_hash;
 }
 
-static List *namewarn_list = 0;
-List *Swig_name_namewarn_list() {
+/* -----------------------------------------------------------------------------
+ * The nameobj lists
+ *
+ * Rename/namewarn rules which cannot go in the above hashes are kept in a
+ * nameobj list, where the most recently added matching rule applies.  Rather
+ * than testing every rule against every declaration, each rule is filed under
+ * a key that any declaration it applies to must have:
+ *
+ *   "name:<targetname>"       rules matching an exact name
+ *   "match:<attrs>:<value>"   rules with a plain match="value" condition
+ *   "generic"                 the rest, e.g. rules with only regex conditions
+ *
+ * A lookup then only tests the generic rules and the rules filed under the
+ * declaration's own keys.  Each rule's "nameobj:seq" records the order in
+ * which rules were added, so that the candidates can be tested in the same
+ * order as the whole list would be.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *NewNameobjList() {
+  Hash *namelist = NewHash();
+  Hash *rules = NewHash();
+  Hash *matchattrs = NewHash();
+  Setattr(namelist, "rules", rules);
+  Setattr(namelist, "matchattrs", matchattrs);
+  Delete(rules);
+  Delete(matchattrs);
+  return namelist;
+}
+
+static Hash *namewarn_list = 0;
+Hash *Swig_name_namewarn_list() {
   if (!namewarn_list)
-    namewarn_list = NewList();
+    namewarn_list = NewNameobjList();
   return namewarn_list;
 }
 
-static List *rename_list = 0;
-List *Swig_name_rename_list() {
+static Hash *rename_list = 0;
+Hash *Swig_name_rename_list() {
   if (!rename_list)
-    rename_list = NewList();
+    rename_list = NewNameobjList();
   return rename_list;
 }
 
@@ -1057,6 +1251,128 @@ int Swig_need_protected(Node *n) {
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * regex_compile()
+ *
+ * Compile a regexmatch/regextarget pattern when a rule is added, so that it is
+ * not compiled again for every declaration the rule is tested against.
+ * ----------------------------------------------------------------------------- */
+
+#ifdef HAVE_PCRE
+#include <pcre.h>
+
+static DOH *regex_compile(Node *n, String *pattern) {
+  const char *err;
+  int errpos;
+  DOH *compiled_pat = Swig_regex_compile(pattern, &err, &errpos);
+  if (!compiled_pat) {
+    Swig_error("SWIG", Getline(n),
+               "Invalid regex \"%s\": compilation failed at %d: %s\n",
+               Char(pattern), errpos, err);
+    exit(1);
+  }
+  return compiled_pat;
+}
+
+static int regexmatch_compiled(Node *n, DOH *compiled_pat, String *pattern, String *s) {
+  int rc = pcre_exec((pcre *)Data(compiled_pat), NULL, Char(s), Len(s), 0, 0, NULL, 0);
+
+  if (rc == PCRE_ERROR_NOMATCH)
+    return 0;
+
+  if (rc < 0 ) {
+    Swig_error("SWIG", Getline(n),
+               "Matching \"%s\" against regex \"%s\" failed: %d\n",
+               Char(s), Char(pattern), rc);
+    exit(1);
+  }
+
+  return 1;
+}
+
+int Swig_name_regexmatch_value(Node *n, String *pattern, String *s) {
+  return regexmatch_compiled(n, regex_compile(n, pattern), pattern, s);
+}
+
+#else /* !HAVE_PCRE */
+
+static DOH *regex_compile(Node *n, String *pattern) {
+  (void)n;
+  (void)pattern;
+  return 0;
+}
+
+int Swig_name_regexmatch_value(Node *n, String *pattern, String *s) {
+  (void)pattern;
+  (void)s;
+  Swig_error("SWIG", Getline(n),
+             "PCRE regex matching is not available in this SWIG build.\n");
+  exit(1);
+}
+
+#endif /* HAVE_PCRE/!HAVE_PCRE */
+
+/* Match s against pattern, using its compiled form if there is one */
+static int regexmatch_value(Node *n, DOH *compiled_pat, String *pattern, String *s) {
+#ifdef HAVE_PCRE
+  if (compiled_pat)
+    return regexmatch_compiled(n, compiled_pat, pattern, s);
+#else
+  (void)compiled_pat;
+#endif
+  return Swig_name_regexmatch_value(n, pattern, s);
+}
+
+/* The key a rule is filed under in a nameobj list */
+static String *nameobj_list_key(Hash *namelist, Hash *nameobj) {
+#if !defined(SWIG_USE_SIMPLE_MATCHOR)
+  String *tname = Getattr(nameobj, "targetname");
+  List *matchlist = Getattr(nameobj, "matchlist");
+  if (tname && !GetFlag(nameobj, "regextarget") && !Getattr(nameobj, "sourcefmt"))
+    return NewStringf("name:%s", tname);
+  if (matchlist) {
+    int ilen = Len(matchlist);
+    int i;
+    for (i = 0; i < ilen; ++i) {
+      Node *mi = Getitem(matchlist, i);
+      String *value = Getattr(mi, "value");
+      if (value && !GetFlag(mi, "notmatch") && !GetFlag(mi, "regexmatch")) {
+	List *attrlist = Getattr(mi, "attrlist");
+	String *attrs = NewStringEmpty();
+	String *key;
+	int j;
+	for (j = 0; j < Len(attrlist); ++j)
+	  Printf(attrs, "%s%s", j ? "$" : "", Getitem(attrlist, j));
+	Setattr(Getattr(namelist, "matchattrs"), attrs, attrlist);
+	key = NewStringf("match:%s:%s", attrs, value);
+	Delete(attrs);
+	return key;
+      }
+    }
+  }
+#else
+  (void)namelist;
+  (void)nameobj;
+#endif
+  return NewString("generic");
+}
+
+static void nameobj_list_add(Hash *namelist, Hash *nameobj) {
+  Hash *rules = Getattr(namelist, "rules");
+  String *key = nameobj_list_key(namelist, nameobj);
+  List *keyrules = Getattr(rules, key);
+  int seq = GetInt(namelist, "count") + 1;
+  if (!keyrules) {
+    keyrules = NewList();
+    Setattr(rules, key, keyrules);
+    Delete(keyrules);
+  }
+  SetInt(namelist, "count", seq);
+  SetInt(nameobj, "nameobj:seq", seq);
+  Append(keyrules, nameobj);
+  Delete(key);
+}
+
 /* -----------------------------------------------------------------------------
  * void Swig_name_nameobj_add()
  *
@@ -1109,8 +1425,12 @@ static void Swig_name_object_attach_keys(const char *keys[], Hash *nameobj) {
 	Setattr(mi, "attrlist", attrlist);
 	if (isnotmatch)
 	  SetFlag(mi, "notmatch");
-	if (isregexmatch)
+	if (isregexmatch) {
+	  DOH *compiled_pat = regex_compile(kw, Getattr(kw, "value"));
 	  SetFlag(mi, "regexmatch");
+	  if (compiled_pat)
+	    Setattr(mi, "regex", compiled_pat);
+	}
 	Delete(attrlist);
 	Append(matchlist, mi);
 	Delete(mi);
@@ -1132,7 +1452,7 @@ static void Swig_name_object_attach_keys(const char *keys[], Hash *nameobj) {
   }
 }
 
-void Swig_name_nameobj_add(Hash *name_hash, List *name_list, String *prefix, String *name, SwigType *decl, Hash *nameobj) {
+void Swig_name_nameobj_add(Hash *name_hash, Hash *name_list, String *prefix, String *name, SwigType *decl, Hash *nameobj) {
   String *nname = 0;
   if (name && Len(name)) {
     String *target_fmt = Getattr(nameobj, "targetfmt");
@@ -1148,11 +1468,15 @@ void Swig_name_nameobj_add(Hash *name_hash, List *name_list, String *prefix, Str
       Getattr(nameobj, "sourcefmt") || Getattr(nameobj, "matchlist") || Getattr(nameobj, "regextarget")) {
     if (decl)
       Setattr(nameobj, "decl", decl);
-    if (nname && Len(nname))
+    if (nname && Len(nname)) {
       Setattr(nameobj, "targetname", nname);
-    /* put the new nameobj at the beginnig of the list, such that the
-       last inserted rule take precedence */
-    Insert(name_list, 0, nameobj);
+      if (GetFlag(nameobj, "regextarget")) {
+	DOH *compiled_pat = regex_compile(nameobj, nname);
+	if (compiled_pat)
+	  Setattr(nameobj, "targetregex", compiled_pat);
+      }
+    }
+    nameobj_list_add(name_list, nameobj);
   } else {
     /* here we add an old 'hash' nameobj, simple and fast */
     Swig_name_object_set(name_hash, nname, decl, nameobj);
@@ -1186,51 +1510,6 @@ static DOH *Swig_get_lattr(Node *n, List *lattr) {
   return res;
 }
 
-#ifdef HAVE_PCRE
-#include <pcre.h>
-
-int Swig_name_regexmatch_value(Node *n, String *pattern, String *s) {
-  pcre *compiled_pat;
-  const char *err;
-  int errpos;
-  int rc;
-
-  compiled_pat = pcre_compile(Char(pattern), 0, &err, &errpos, NULL);
-  if (!compiled_pat) {
-    Swig_error("SWIG", Getline(n),
-               "Invalid regex \"%s\": compilation failed at %d: %s\n",
-               Char(pattern), errpos, err);
-    exit(1);
-  }
-
-  rc = pcre_exec(compiled_pat, NULL, Char(s), Len(s), 0, 0, NULL, 0);
-  pcre_free(compiled_pat);
-
-  if (rc == PCRE_ERROR_NOMATCH)
-    return 0;
-
-  if (rc < 0 ) {
-    Swig_error("SWIG", Getline(n),
-               "Matching \"%s\" against regex \"%s\" failed: %d\n",
-               Char(s), Char(pattern), rc);
-    exit(1);
-  }
-
-  return 1;
-}
-
-#else /* !HAVE_PCRE */
-
-int Swig_name_regexmatch_value(Node *n, String *pattern, String *s) {
-  (void)pattern;
-  (void)s;
-  Swig_error("SWIG", Getline(n),
-             "PCRE regex matching is not available in this SWIG build.\n");
-  exit(1);
-}
-
-#endif /* HAVE_PCRE/!HAVE_PCRE */
-
 int Swig_name_match_value(String *mvalue, String *value) {
 #if defined(SWIG_USE_SIMPLE_MATCHOR)
   int match = 0;
@@ -1276,7 +1555,7 @@ int Swig_name_match_nameobj(Hash *rn, Node *n) {
       match = 0;
       if (nval) {
 	String *kwval = Getattr(mi, "value");
-	match = regexmatch ? Swig_name_regexmatch_value(n, kwval, nval)
+	match = regexmatch ? regexmatch_value(n, Getattr(mi, "regex"), kwval, nval)
 	    : Swig_name_match_value(kwval, nval);
 #ifdef SWIG_DEBUG
 	Printf(stdout, "val %s %s %d %d \n", nval, kwval, match, ilen);
@@ -1299,58 +1578,115 @@ int Swig_name_match_nameobj(Hash *rn, Node *n) {
  * 
  * ----------------------------------------------------------------------------- */
 
-Hash *Swig_name_nameobj_lget(List *namelist, Node *n, String *prefix, String *name, String *decl) {
+static int nameobj_match(Hash *rn, Node *n, String *prefix, String *name, String *decl) {
+  int match = 0;
+  String *rdecl = Getattr(rn, "decl");
+  if (rdecl && (!decl || !Equal(rdecl, decl))) {
+    return 0;
+  } else if (Swig_name_match_nameobj(rn, n)) {
+    String *tname = Getattr(rn, "targetname");
+    if (tname) {
+      String *sfmt = Getattr(rn, "sourcefmt");
+      String *sname = 0;
+      int fullname = GetFlag(rn, "fullname");
+      int regextarget = GetFlag(rn, "regextarget");
+      if (sfmt) {
+	if (fullname && prefix) {
+	  String *pname = NewStringf("%s::%s", prefix, name);
+	  sname = NewStringf(sfmt, pname);
+	  Delete(pname);
+	} else {
+	  sname = NewStringf(sfmt, name);
+	}
+      } else {
+	if (fullname && prefix) {
+	  sname = NewStringf("%s::%s", prefix, name);
+	} else {
+	  sname = name;
+	  DohIncref(name);
+	}
+      }
+      match = regextarget ? regexmatch_value(n, Getattr(rn, "targetregex"), tname, sname)
+	: Swig_name_match_value(tname, sname);
+      Delete(sname);
+    } else {
+      /* Applying the renaming rule may fail if it contains a %(regex)s expression that doesn't match the given name. */
+      String *sname = NewStringf(Getattr(rn, "name"), name);
+      if (sname) {
+	if (Len(sname))
+	  match = 1;
+	Delete(sname);
+      }
+    }
+  }
+  return match;
+}
+
+static void nameobj_list_candidates(List *candidates, Hash *rules, String *key) {
+  List *keyrules = Getattr(rules, key);
+  if (keyrules)
+    Append(candidates, keyrules);
+}
+
+Hash *Swig_name_nameobj_lget(Hash *namelist, Node *n, String *prefix, String *name, String *decl) {
   Hash *res = 0;
   if (namelist) {
-    int len = Len(namelist);
-    int i;
-    int match = 0;
-    for (i = 0; !match && (i < len); i++) {
-      Hash *rn = Getitem(namelist, i);
-      String *rdecl = Getattr(rn, "decl");
-      if (rdecl && (!decl || !Equal(rdecl, decl))) {
-	continue;
-      } else if (Swig_name_match_nameobj(rn, n)) {
-	String *tname = Getattr(rn, "targetname");
-	if (tname) {
-	  String *sfmt = Getattr(rn, "sourcefmt");
-	  String *sname = 0;
-	  int fullname = GetFlag(rn, "fullname");
-	  int regextarget = GetFlag(rn, "regextarget");
-	  if (sfmt) {
-	    if (fullname && prefix) {
-	      String *pname = NewStringf("%s::%s", prefix, name);
-	      sname = NewStringf(sfmt, pname);
-	      Delete(pname);
-	    } else {
-	      sname = NewStringf(sfmt, name);
-	    }
-	  } else {
-	    if (fullname && prefix) {
-	      sname = NewStringf("%s::%s", prefix, name);
-	    } else {
-	      sname = name;
-	      DohIncref(name);
-	    }
-	  }
-	  match = regextarget ? Swig_name_regexmatch_value(n, tname, sname)
-	    : Swig_name_match_value(tname, sname);
-	  Delete(sname);
-	} else {
-	  /* Applying the renaming rule may fail if it contains a %(regex)s expression that doesn't match the given name. */
-	  String *sname = NewStringf(Getattr(rn, "name"), name);
-	  if (sname) {
-	    if (Len(sname))
-	      match = 1;
-	    Delete(sname);
+    Hash *rules = Getattr(namelist, "rules");
+    List *candidates = NewList();
+    String *key = NewString("generic");
+    Iterator ki;
+    int nlists;
+    int *pos;
+    int k;
+
+    /* The lists of rules which might apply to n */
+    nameobj_list_candidates(candidates, rules, key);
+    if (name) {
+      Clear(key);
+      Printf(key, "name:%s", name);
+      nameobj_list_candidates(candidates, rules, key);
+      if (prefix) {
+	Clear(key);
+	Printf(key, "name:%s::%s", prefix, name);
+	nameobj_list_candidates(candidates, rules, key);
+      }
+    }
+    for (ki = First(Getattr(namelist, "matchattrs")); ki.key; ki = Next(ki)) {
+      String *nval = Swig_get_lattr(n, ki.item);
+      if (nval && DohIsString(nval)) {
+	Clear(key);
+	Printf(key, "match:%s:%s", ki.key, nval);
+	nameobj_list_candidates(candidates, rules, key);
+      }
+    }
+    Delete(key);
+
+    /* Test them most recently added first, merging the lists by sequence number */
+    nlists = Len(candidates);
+    pos = (int *)malloc(sizeof(int) * (nlists + 1));
+    for (k = 0; k < nlists; ++k)
+      pos[k] = Len(Getitem(candidates, k)) - 1;
+    for (;;) {
+      int best = -1;
+      int bestseq = 0;
+      for (k = 0; k < nlists; ++k) {
+	if (pos[k] >= 0) {
+	  int seq = GetInt(Getitem(Getitem(candidates, k), pos[k]), "nameobj:seq");
+	  if (best < 0 || seq > bestseq) {
+	    best = k;
+	    bestseq = seq;
 	  }
 	}
       }
-      if (match) {
-	res = rn;
+      if (best < 0)
 	break;
-      }
+      res = Getitem(Getitem(candidates, best), pos[best]--);
+      if (nameobj_match(res, n, prefix, name, decl))
+	break;
+      res = 0;
     }
+    free(pos);
+    Delete(candidates);
   }
   return res;
 }
@@ -461,6 +461,7 @@ SwigType *SwigType_default_deduce(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 String *SwigType_namestr(const SwigType *t) {
+  Hash *node;
   String *r;
   String *suffix;
   List *p;
@@ -471,6 +472,11 @@ String *SwigType_namestr(const SwigType *t) {
   if (!c || !strstr(c + 2, ")>"))
     return NewString(t);
 
+  node = SwigType_intern(t);
+  r = Getattr(node, "namestr");
+  if (r)
+    return Copy(r);
+
   r = NewStringWithSize(d, c - d);
   if (*(c - 1) == '<')
     Putc(' ', r);
@@ -500,7 +506,9 @@ String *SwigType_namestr(const SwigType *t) {
   }
   Delete(suffix);
   Delete(p);
-  return r;
+  Setattr(node, "namestr", r);
+  Delete(r);
+  return Copy(r);
 }
 
 /* -----------------------------------------------------------------------------
@@ -510,6 +518,7 @@ String *SwigType_namestr(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
+  Hash *node = 0;
   String *result;
   String *element = 0;
   String *nextelement;
@@ -517,6 +526,14 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
   List *elements;
   int nelements, i;
 
+  if (!id) {
+    /* Only the plain C form of the type is cached */
+    node = SwigType_intern(s);
+    result = Getattr(node, "str");
+    if (result)
+      return Copy(result);
+  }
+
   if (id) {
     /* stringify the id expanding templates, for example when the id is a fully qualified templated class name */
     String *id_str = NewString(id); /* unfortunate copy due to current const limitations */
@@ -608,6 +625,11 @@ String *SwigType_str(const SwigType *s, const_String_or_char_ptr id) {
   }
   Delete(elements);
   Chop(result);
+  if (node) {
+    Setattr(node, "str", result);
+    Delete(result);
+    return Copy(result);
+  }
   return result;
 }
 
@@ -130,6 +130,7 @@ extern "C" {
   extern SwigType *SwigType_add_template(SwigType *t, ParmList *parms);
   extern SwigType *SwigType_pop_function(SwigType *t);
   extern ParmList *SwigType_function_parms(const SwigType *t, Node *file_line_node);
+  extern Hash *SwigType_intern(const SwigType *t);
   extern List *SwigType_split(const SwigType *t);
   extern String *SwigType_pop(SwigType *t);
   extern void SwigType_push(SwigType *t, String *s);
@@ -193,6 +194,9 @@ extern "C" {
   extern Typetab *SwigType_pop_scope(void);
   extern Typetab *SwigType_set_scope(Typetab *h);
   extern void SwigType_print_scope(void);
+  extern int SwigType_typesystem_generation(void);
+  extern void SwigType_typedef_cache_debug_set(void);
+  extern void SwigType_typedef_cache_debug_stats(void);
   extern SwigType *SwigType_typedef_resolve(const SwigType *t);
   extern SwigType *SwigType_typedef_resolve_all(const SwigType *t);
   extern SwigType *SwigType_typedef_qualified(const SwigType *t);
@@ -295,6 +299,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_name_object_inherit(Hash *namehash, String *base, String *derived);
   extern void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *n);
   extern void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *decl, const_String_or_char_ptr featurename, String *value, Hash *featureattribs);
+  extern void Swig_features_debug_stats(void);
 
 /* --- Misc --- */
   extern char *Swig_copy_string(const char *c);
@@ -319,6 +324,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern String *Swig_string_upper(String *s);
   extern String *Swig_string_title(String *s);
   extern String *Swig_pcre_version(void);
+  extern DOH *Swig_regex_compile(String *pattern, const char **error, int *errorpos);
   extern void Swig_init(void);
   extern int Swig_value_wrapper_mode(int mode);
 
@@ -389,6 +395,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_typemap_clear_apply(ParmList *pattern);
   extern void Swig_typemap_debug(void);
   extern void Swig_typemap_search_debug_set(void);
+  extern void Swig_typemap_search_debug_stats(void);
   extern void Swig_typemap_used_debug_set(void);
   extern void Swig_typemap_register_debug_set(void);
 
@@ -15,6 +15,7 @@ extern List   *Swig_add_directory(const_String_or_char_ptr dirname);
 extern void    Swig_push_directory(const_String_or_char_ptr dirname);
 extern void    Swig_pop_directory(void);
 extern String *Swig_last_file(void);
+extern void    Swig_set_missed_files(List *missed);
 extern List   *Swig_search_path(void);
 extern FILE   *Swig_include_open(const_String_or_char_ptr name);
 extern FILE   *Swig_open(const_String_or_char_ptr name);
@@ -24,7 +24,15 @@ static int typemaps_used_debug = 0;
 static int typemap_register_debug = 0;
 static int in_typemap_search_multi = 0;
 
+/* Memoized typemap_search() results, see typemap_search() */
+static Hash *typemap_search_cache = 0;
+static Hash *typemap_pnames = 0;	/* Parameter names used in any typemap */
+static int typemap_search_cache_generation = -1;
+static int typemap_search_cache_hits = 0;
+static int typemap_search_cache_misses = 0;
+
 static void replace_embedded_typemap(String *s, ParmList *parm_sublist, Wrapper *f, Node *file_line_node);
+static void typemap_search_cache_flush(void);
 
 /* -----------------------------------------------------------------------------
  * Typemaps are stored in a collection of nested hash tables.  Something like
@@ -131,6 +139,19 @@ void Swig_typemap_init() {
   }
   typemaps[0] = NewHash();
   tm_scope = 0;
+  typemap_search_cache_flush();
+}
+
+/* -----------------------------------------------------------------------------
+ * typemap_search_cache_flush()
+ *
+ * Discard all memoized typemap search results.  Must be called whenever the
+ * typemaps change.
+ * ----------------------------------------------------------------------------- */
+
+static void typemap_search_cache_flush(void) {
+  Delete(typemap_search_cache);
+  typemap_search_cache = 0;
 }
 
 static String *typemap_method_name(const_String_or_char_ptr tmap_method) {
@@ -170,6 +191,7 @@ static String *typemap_method_name(const_String_or_char_ptr tmap_method) {
 void Swig_typemap_new_scope() {
   tm_scope++;
   typemaps[tm_scope] = NewHash();
+  typemap_search_cache_flush();
 }
 
 /* -----------------------------------------------------------------------------
@@ -180,6 +202,7 @@ void Swig_typemap_new_scope() {
 
 Hash *Swig_typemap_pop_scope() {
   if (tm_scope > 0) {
+    typemap_search_cache_flush();
     return typemaps[tm_scope--];
   }
   return 0;
@@ -208,12 +231,19 @@ static void typemap_register(const_String_or_char_ptr tmap_method, ParmList *par
       Swig_print_node(parms);
   }
 
+  typemap_search_cache_flush();
+
   tm_method = typemap_method_name(tmap_method);
 
   /* Register the first type in the parameter list */
 
   type = Getattr(parms, "type");
   pname = Getattr(parms, "name");
+  if (pname) {
+    if (!typemap_pnames)
+      typemap_pnames = NewHash();
+    Setattr(typemap_pnames, pname, "1");
+  }
 
   /* See if this type has been seen before */
   tm = get_typemap(tm_scope, type);
@@ -405,6 +435,8 @@ void Swig_typemap_clear(const_String_or_char_ptr tmap_method, ParmList *parms) {
   String *multi_tmap_method;
   Hash *tm = 0;
 
+  typemap_search_cache_flush();
+
   /* This might not work */
   multi_tmap_method = NewString(tmap_method);
   p = parms;
@@ -459,6 +491,8 @@ int Swig_typemap_apply(ParmList *src, ParmList *dest) {
 
   /*  Printf(stdout,"apply : %s --> %s\n", ParmList_str(src), ParmList_str(dest)); */
 
+  typemap_search_cache_flush();
+
   /* Create type signature of source */
   ssig = NewStringEmpty();
   dsig = NewStringEmpty();
@@ -584,6 +618,8 @@ void Swig_typemap_clear_apply(Parm *parms) {
   Hash *tm;
   String *name;
 
+  typemap_search_cache_flush();
+
   /* Create a type signature of the parameters */
   tsig = NewStringEmpty();
   p = parms;
@@ -697,14 +733,14 @@ ret_result:
 }
 
 /* -----------------------------------------------------------------------------
- * typemap_search()
+ * typemap_search_impl()
  *
  * Search for a typemap match. This is where the typemap pattern matching rules 
  * are implemented... tries to find the most specific typemap that includes a 
  * 'code' attribute.
  * ----------------------------------------------------------------------------- */
 
-static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+static Hash *typemap_search_impl(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
   Hash *result = 0;
   Hash *tm;
   Hash *backup = 0;
@@ -819,6 +855,71 @@ ret_result:
 }
 
 
+/* -----------------------------------------------------------------------------
+ * typemap_search()
+ *
+ * Memoizing front end to typemap_search_impl().  The same types are looked up
+ * for every parameter of every wrapper, so results are cached on the typemap
+ * method, type, name and qualified name.  Typedef resolution and template
+ * default types depend on the current type system state and symbol scope, so
+ * these are part of the key too.  The cache is flushed whenever typemaps are
+ * added, copied, cleared or applied.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+  Hash *result;
+  Hash *entry;
+  String *key;
+  SwigType *mtype = 0;
+  const_String_or_char_ptr key_name = "";
+  const_String_or_char_ptr key_qualifiedname = "";
+  int debug_display = (in_typemap_search_multi == 0) && typemap_search_debug;
+  int generation = SwigType_typesystem_generation();
+
+  if (!typemap_search_cache || generation != typemap_search_cache_generation) {
+    Delete(typemap_search_cache);
+    typemap_search_cache = NewHash();
+    typemap_search_cache_generation = generation;
+  }
+  /* A name only takes part in matching if some typemap uses it, so other names share one cache entry */
+  if (name && typemap_pnames && Getattr(typemap_pnames, name))
+    key_name = name;
+  if (qualifiedname && typemap_pnames && Getattr(typemap_pnames, qualifiedname))
+    key_qualifiedname = qualifiedname;
+  key = NewStringf("%s|%s|%s|%s|%p", tmap_method, type, key_name, key_qualifiedname, Swig_symbol_current());
+  entry = Getattr(typemap_search_cache, key);
+  if (entry) {
+    typemap_search_cache_hits++;
+    if (!debug_display) {
+      /* Display of the search steps requires a real search, otherwise use the memoized result */
+      if (matchtype)
+	*matchtype = Copy(Getattr(entry, "match"));
+      Delete(key);
+      return Getattr(entry, "typemap");
+    }
+  } else {
+    typemap_search_cache_misses++;
+  }
+
+  result = typemap_search_impl(tmap_method, type, name, qualifiedname, &mtype, node);
+
+  if (!entry) {
+    entry = NewHash();
+    if (result)
+      Setattr(entry, "typemap", result);
+    if (mtype)
+      Setattr(entry, "match", mtype);
+    Setattr(typemap_search_cache, key, entry);
+    Delete(entry);
+  }
+  if (matchtype)
+    *matchtype = mtype;
+  else
+    Delete(mtype);
+  Delete(key);
+  return result;
+}
+
 /* -----------------------------------------------------------------------------
  * typemap_search_multi()
  *
@@ -2078,6 +2179,18 @@ void Swig_typemap_search_debug_set(void) {
   typemap_search_debug = 1;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_debug_stats()
+ *
+ * Display typemap search cache statistics
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_debug_stats(void) {
+  int total = typemap_search_cache_hits + typemap_search_cache_misses;
+  Printf(stdout, "Typemap search cache: %d searches, %d hits, %d misses (%.1f%% hit rate)\n",
+	 total, typemap_search_cache_hits, typemap_search_cache_misses, total ? 100.0 * typemap_search_cache_hits / total : 0.0);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_typemap_used_debug_set()
  *
@@ -122,6 +122,59 @@ SwigType *NewSwigType(const_String_or_char_ptr initial) {
 
 #endif
 
+/* -----------------------------------------------------------------------------
+ * SwigType_intern()
+ *
+ * Returns the interned node of a type.  There is one node per distinct type
+ * encoding, so two types are equal exactly when their interned nodes are the
+ * same object.  The node's "type" attribute is the canonical copy of the
+ * encoding and must not be modified.
+ *
+ * The node also caches the results of the functions which take a type apart,
+ * such as SwigType_split() and SwigType_str(), as these only depend on the
+ * encoding but are called over and over again for the same few types during
+ * typemap matching and typedef resolution.  These functions still return a
+ * new object, owned by the caller, each time they are called.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *interned_types = 0;
+
+Hash *SwigType_intern(const SwigType *t) {
+  Hash *node;
+  if (!DohCheck(t)) {
+    /* Don't make a permanent hash key out of a char * */
+    String *st = NewString(t);
+    node = SwigType_intern(st);
+    Delete(st);
+    return node;
+  }
+  if (!interned_types)
+    interned_types = NewHash();
+  node = Getattr(interned_types, t);
+  if (!node) {
+    String *type = NewString(t);
+    node = NewHash();
+    Setattr(node, "type", type);
+    Setattr(interned_types, type, node);
+    Delete(type);
+    Delete(node);
+  }
+  return node;
+}
+
+/* A copy of a cached list of strings, which the caller may modify */
+static List *copy_string_list(List *cached) {
+  int i;
+  int len = Len(cached);
+  List *list = NewList();
+  for (i = 0; i < len; i++) {
+    String *item = NewString(Getitem(cached, i));
+    Append(list, item);
+    Delete(item);
+  }
+  return list;
+}
+
 /* The next few functions are utility functions used in the construction and 
    management of types */
 
@@ -240,11 +293,16 @@ String *SwigType_parm(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 List *SwigType_split(const SwigType *t) {
+  Hash *node = SwigType_intern(t);
   String *item;
   List *list;
   char *c;
   int len;
 
+  list = Getattr(node, "split");
+  if (list)
+    return copy_string_list(list);
+
   c = Char(t);
   list = NewList();
   while (*c) {
@@ -256,7 +314,9 @@ List *SwigType_split(const SwigType *t) {
     if (*c == '.')
       c++;
   }
-  return list;
+  Setattr(node, "split", list);
+  Delete(list);
+  return copy_string_list(list);
 }
 
 /* -----------------------------------------------------------------------------
@@ -276,6 +336,7 @@ List *SwigType_split(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
  
 List *SwigType_parmlist(const String *p) {
+  Hash *node;
   String *item = 0;
   List *list;
   char *c;
@@ -283,11 +344,18 @@ List *SwigType_parmlist(const String *p) {
   int size;
 
   assert(p);
+  node = SwigType_intern(p);
+  list = Getattr(node, "parmlist");
+  if (list)
+    return list == None ? 0 : copy_string_list(list);
+
   c = Char(p);
   while (*c && (*c != '(') && (*c != '.'))
     c++;
-  if (!*c)
+  if (!*c) {
+    Setattr(node, "parmlist", None);
     return 0;
+  }
   assert(*c != '.'); /* p is expected to contain sub elements of a type */
   c++;
   list = NewList();
@@ -324,7 +392,9 @@ List *SwigType_parmlist(const String *p) {
     Append(list, item);
   }
   Delete(item);
-  return list;
+  Setattr(node, "parmlist", list);
+  Delete(list);
+  return copy_string_list(list);
 }
 
 /* -----------------------------------------------------------------------------
@@ -1124,14 +1194,12 @@ String *SwigType_prefix(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 SwigType *SwigType_strip_qualifiers(const SwigType *t) {
-  static Hash *memoize_stripped = 0;
+  Hash *node = SwigType_intern(t);
   SwigType *r;
   List *l;
   Iterator ei;
 
-  if (!memoize_stripped)
-    memoize_stripped = NewHash();
-  r = Getattr(memoize_stripped, t);
+  r = Getattr(node, "strip_qualifiers");
   if (r)
     return Copy(r);
 
@@ -1145,11 +1213,8 @@ SwigType *SwigType_strip_qualifiers(const SwigType *t) {
   }
   Delete(l);
   {
-    String *key, *value;
-    key = Copy(t);
-    value = Copy(r);
-    Setattr(memoize_stripped, key, value);
-    Delete(key);
+    String *value = Copy(r);
+    Setattr(node, "strip_qualifiers", value);
     Delete(value);
   }
   return r;
@@ -1168,14 +1233,12 @@ SwigType *SwigType_strip_qualifiers(const SwigType *t) {
  * ----------------------------------------------------------------------------- */
 
 SwigType *SwigType_strip_single_qualifier(const SwigType *t) {
-  static Hash *memoize_stripped = 0;
+  Hash *node = SwigType_intern(t);
   SwigType *r = 0;
   List *l;
   int numitems;
 
-  if (!memoize_stripped)
-    memoize_stripped = NewHash();
-  r = Getattr(memoize_stripped, t);
+  r = Getattr(node, "strip_single_qualifier");
   if (r)
     return Copy(r);
 
@@ -1203,11 +1266,8 @@ SwigType *SwigType_strip_single_qualifier(const SwigType *t) {
 
   Delete(l);
   {
-    String *key, *value;
-    key = Copy(t);
-    value = Copy(r);
-    Setattr(memoize_stripped, key, value);
-    Delete(key);
+    String *value = Copy(r);
+    Setattr(node, "strip_single_qualifier", value);
     Delete(value);
   }
   return r;
@@ -113,6 +113,12 @@ static Hash *typedef_qualified_cache = 0;
 static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix);
 
 /* common attribute keys, to avoid calling find_key all the times */
+static String *k_value = 0;
+static String *k_scope = 0;
+static String *k_deps = 0;
+static String *k_cache = 0;
+static String *k_key = 0;
+static String *k_epoch = 0;
 
 /* 
    Enable this one if your language fully support SwigValueWrapper<T>.
@@ -131,10 +137,330 @@ int Swig_value_wrapper_mode(int mode) {
 }
 
 
+static int typesystem_generation = 0;
+
+/* -----------------------------------------------------------------------------
+ * Typedef resolution caches
+ *
+ * The results of SwigType_typedef_resolve(), SwigType_typedef_resolve_all()
+ * and SwigType_typedef_qualified() depend on the scope they are looked up
+ * from, so every type scope has its own set of the three caches, kept in
+ * typedef_cache_scopes rather than in the scope itself.  These survive
+ * switching between scopes, so the caches filled while parsing are still
+ * used by the typepass and the language modules.
+ *
+ * Each cache entry is a hash with the following attributes:
+ *
+ *    "value"           -  The result, not present if there was no result
+ *    "deps"            -  Hash of the names the result was computed from
+ *    "cache", "key"    -  Where the entry is stored
+ *    "epoch"           -  Only with -debug-typedef, see flush_cache()
+ *
+ * The names an entry depends on are the typetab names and qualified scope
+ * names that were looked up.  typedef_cache_index maps each of these names to
+ * the entries that depend on it, so a new typedef, scope or alias only throws
+ * away the entries that looked up the name it defines.  Changing the
+ * "inherit" or "using" list of a scope throws away all the caches of the
+ * scopes whose lookups searched that list, as recorded in
+ * typedef_cache_visitors.  Results computed by nested lookups are cached too and
+ * their dependencies are added to those of the enclosing lookup, except for
+ * lookups made by SwigType_find_scope(), which skip the scopes it has marked
+ * and so are not valid elsewhere.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typedef_cache_scopes = 0;	/* Scope address -> hash of the scope's caches */
+static Hash *typedef_cache_index = 0;	/* Dependency name -> list of cache entries    */
+static Hash *typedef_cache_visitors = 0;	/* Scope address -> caches of the scopes searching it */
+static Hash *typedef_cache_deps = 0;	/* Dependencies of the lookup in progress      */
+static String *typedef_cache_epoch = 0;
+static int typedef_cache_nostore = 0;	/* Set while lookups skip marked scopes         */
+
+typedef struct {
+  const char *name;
+  int hits;
+  int retained;
+  int misses;
+} TypedefCacheStats;
+
+static TypedefCacheStats typedef_resolve_stats = { "resolve", 0, 0, 0 };
+static TypedefCacheStats typedef_all_stats = { "resolve_all", 0, 0, 0 };
+static TypedefCacheStats typedef_qualified_stats = { "qualified", 0, 0, 0 };
+static int typedef_cache_invalidated = 0;
+static int typedef_cache_flushes = 0;
+static int typedef_cache_debug = 0;
+
+#define TYPEDEF_CACHE_SCOPE_KEY(buf, s) sprintf(buf, "%p", (void *)(s))
+
+/* -----------------------------------------------------------------------------
+ * flush_cache()
+ *
+ * Called wherever the type system or the current scope changes.  The caches
+ * used to be thrown away here; now this only records the point for the
+ * statistics: a hit on an entry made before the last such point is counted
+ * as retained.
+ * ----------------------------------------------------------------------------- */
+
 static void flush_cache() {
-  typedef_resolve_cache = 0;
-  typedef_all_cache = 0;
-  typedef_qualified_cache = 0;
+  if (typedef_cache_debug) {
+    Delete(typedef_cache_epoch);
+    typedef_cache_epoch = NewStringEmpty();
+  }
+  typedef_cache_flushes++;
+  typesystem_generation++;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_typesystem_generation()
+ *
+ * Returns a number that changes whenever typedefs or the current type scope
+ * change, that is, whenever the result of resolving a type may change.  Used
+ * to invalidate caches of results derived from type resolution.
+ * ----------------------------------------------------------------------------- */
+
+int SwigType_typesystem_generation(void) {
+  return typesystem_generation;
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_set_scope()
+ *
+ * Switch the typedef caches to those of the current scope.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_set_scope() {
+  char key[64];
+  Hash *caches;
+  if (!typedef_cache_scopes)
+    typedef_cache_scopes = NewHash();
+  TYPEDEF_CACHE_SCOPE_KEY(key, current_scope);
+  caches = Getattr(typedef_cache_scopes, key);
+  if (!caches) {
+    caches = NewHash();
+    Setattr(caches, "resolve", NewHash());
+    Setattr(caches, "all", NewHash());
+    Setattr(caches, "qualified", NewHash());
+    /* Keeps the scope alive, so its address is not reused by another scope */
+    Setattr(caches, "scope", current_scope);
+    Setattr(typedef_cache_scopes, key, caches);
+    Delete(Getattr(caches, "resolve"));
+    Delete(Getattr(caches, "all"));
+    Delete(Getattr(caches, "qualified"));
+    Delete(caches);
+  }
+  typedef_resolve_cache = Getattr(caches, "resolve");
+  typedef_all_cache = Getattr(caches, "all");
+  typedef_qualified_cache = Getattr(caches, "qualified");
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_depend()
+ *
+ * Record that the lookup in progress depends on the given name.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_depend(const_String_or_char_ptr name) {
+  if (typedef_cache_deps && !Getattr(typedef_cache_deps, name)) {
+    String *key = NewString(name);
+    Setattr(typedef_cache_deps, key, key);
+    Delete(key);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_depend_scope()
+ *
+ * Record that the lookup in progress searched the inheritance of a scope.
+ * All lookups are made from the current scope.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_depend_scope(Typetab *s) {
+  if (typedef_cache_deps) {
+    char key[64];
+    Hash *visitors;
+    if (!typedef_cache_visitors)
+      typedef_cache_visitors = NewHash();
+    TYPEDEF_CACHE_SCOPE_KEY(key, s);
+    visitors = Getattr(typedef_cache_visitors, key);
+    if (!visitors) {
+      visitors = NewHash();
+      Setattr(typedef_cache_visitors, key, visitors);
+      Delete(visitors);
+    }
+    TYPEDEF_CACHE_SCOPE_KEY(key, current_scope);
+    if (!Getattr(visitors, key))
+      Setattr(visitors, key, Getattr(typedef_cache_scopes, key));
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_get()
+ *
+ * Look up a cache entry and merge its dependencies into those of the
+ * enclosing lookup, if any.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typedef_cache_get(Hash *cache, const SwigType *t, TypedefCacheStats *stats) {
+  Hash *entry = Getattr(cache, t);
+  if (entry) {
+    stats->hits++;
+    if (typedef_cache_debug && Getattr(entry, k_epoch) != typedef_cache_epoch)
+      stats->retained++;
+    if (typedef_cache_deps) {
+      Iterator i;
+      for (i = First(Getattr(entry, k_deps)); i.key; i = Next(i)) {
+	if (!Getattr(typedef_cache_deps, i.key))
+	  Setattr(typedef_cache_deps, i.key, i.key);
+      }
+    }
+  } else {
+    stats->misses++;
+  }
+  return entry;
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_begin()
+ * typedef_cache_end()
+ *
+ * Bracket a lookup whose result is to be cached so that its dependencies are
+ * collected.  typedef_cache_begin() returns the dependencies of the enclosing
+ * lookup, which must be passed to typedef_cache_end().  value may be null.
+ * Returns the new entry, or null if it was not stored.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typedef_cache_begin() {
+  Hash *outer = typedef_cache_deps;
+  typedef_cache_deps = NewHash();
+  return outer;
+}
+
+static Hash *typedef_cache_end(Hash *cache, const SwigType *t, const SwigType *value, Hash *outer) {
+  Hash *entry = NewHash();
+  String *key = NewString(t);
+  Iterator i;
+
+  if (typedef_cache_nostore) {
+    for (i = First(typedef_cache_deps); i.key; i = Next(i)) {
+      if (outer && !Getattr(outer, i.key))
+	Setattr(outer, i.key, i.key);
+    }
+    Delete(typedef_cache_deps);
+    typedef_cache_deps = outer;
+    Delete(entry);
+    Delete(key);
+    return 0;
+  }
+  if (!typedef_cache_index)
+    typedef_cache_index = NewHash();
+  if (value) {
+    SwigType *v = Copy(value);
+    Setattr(entry, k_value, v);
+    Delete(v);
+  }
+  Setattr(entry, k_deps, typedef_cache_deps);
+  Setattr(entry, k_cache, cache);
+  Setattr(entry, k_key, key);
+  if (typedef_cache_debug)
+    Setattr(entry, k_epoch, typedef_cache_epoch);
+  for (i = First(typedef_cache_deps); i.key; i = Next(i)) {
+    List *entries = Getattr(typedef_cache_index, i.key);
+    if (!entries) {
+      entries = NewList();
+      Setattr(typedef_cache_index, i.key, entries);
+      Delete(entries);
+    }
+    Append(entries, entry);
+    if (outer && !Getattr(outer, i.key))
+      Setattr(outer, i.key, i.key);
+  }
+  Setattr(cache, key, entry);
+  Delete(typedef_cache_deps);
+  typedef_cache_deps = outer;
+  Delete(key);
+  Delete(entry);
+  return entry;
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_invalidate()
+ *
+ * Remove the cache entries which depend on the given name.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_invalidate(const_String_or_char_ptr name) {
+  List *entries = typedef_cache_index ? Getattr(typedef_cache_index, name) : 0;
+  if (entries) {
+    Iterator i;
+    for (i = First(entries); i.item; i = Next(i)) {
+      Hash *cache = Getattr(i.item, k_cache);
+      String *key = Getattr(i.item, k_key);
+      /* The entry may already have been replaced by a newer one */
+      if (Getattr(cache, key) == i.item) {
+	Delattr(cache, key);
+	typedef_cache_invalidated++;
+      }
+    }
+    Delattr(typedef_cache_index, name);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * typedef_cache_invalidate_scope()
+ *
+ * Empty the caches of the scopes whose lookups searched the inheritance of
+ * the given scope.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_invalidate_scope(Typetab *s) {
+  char key[64];
+  Hash *visitors;
+  TYPEDEF_CACHE_SCOPE_KEY(key, s);
+  visitors = typedef_cache_visitors ? Getattr(typedef_cache_visitors, key) : 0;
+  if (visitors) {
+    static const char *names[] = { "resolve", "all", "qualified" };
+    Iterator i;
+    int j;
+    for (i = First(visitors); i.key; i = Next(i)) {
+      for (j = 0; j < 3; j++) {
+	Hash *cache = Getattr(i.item, names[j]);
+	typedef_cache_invalidated += Len(cache);
+	Clear(cache);
+      }
+    }
+    Delattr(typedef_cache_visitors, key);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_typedef_cache_debug_set()
+ *
+ * Turn on the collection of typedef resolution cache statistics
+ * ----------------------------------------------------------------------------- */
+
+void SwigType_typedef_cache_debug_set(void) {
+  typedef_cache_debug = 1;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_typedef_cache_debug_stats()
+ *
+ * Display typedef resolution cache statistics.  Retained hits are those on
+ * entries that survived a change to the type system or the current scope.
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_print_stats(TypedefCacheStats *stats) {
+  int total = stats->hits + stats->misses;
+  Printf(stdout, "  %-12s %d lookups, %d hits, %d misses (%.1f%% hit rate), %d retained hits (%.1f%% of lookups)\n",
+	 stats->name, total, stats->hits, stats->misses, total ? 100.0 * stats->hits / total : 0.0,
+	 stats->retained, total ? 100.0 * stats->retained / total : 0.0);
+}
+
+void SwigType_typedef_cache_debug_stats(void) {
+  Printf(stdout, "Typedef resolution caches: %d scopes, %d type system or scope changes, %d entries invalidated\n",
+	 typedef_cache_scopes ? Len(typedef_cache_scopes) : 0, typedef_cache_flushes, typedef_cache_invalidated);
+  typedef_cache_print_stats(&typedef_resolve_stats);
+  typedef_cache_print_stats(&typedef_all_stats);
+  typedef_cache_print_stats(&typedef_qualified_stats);
 }
 
 /* Initialize the scoping system */
@@ -144,6 +470,21 @@ void SwigType_typesystem_init() {
     Delete(global_scope);
   if (scopes)
     Delete(scopes);
+  Delete(typedef_cache_scopes);
+  typedef_cache_scopes = 0;
+  Delete(typedef_cache_index);
+  typedef_cache_index = 0;
+  Delete(typedef_cache_visitors);
+  typedef_cache_visitors = 0;
+
+  if (!k_value) {
+    k_value = NewString("value");
+    k_scope = NewString("scope");
+    k_deps = NewString("deps");
+    k_cache = NewString("cache");
+    k_key = NewString("key");
+    k_epoch = NewString("epoch");
+  }
 
   current_scope = NewHash();
   global_scope = current_scope;
@@ -155,6 +496,7 @@ void SwigType_typesystem_init() {
   current_symtab = 0;
   scopes = NewHash();
   Setattr(scopes, "", current_scope);
+  typedef_cache_set_scope();
 }
 
 
@@ -184,6 +526,7 @@ int SwigType_typedef(const SwigType *type, const_String_or_char_ptr name) {
     }
   }
   Setattr(current_typetab, name, type);
+  typedef_cache_invalidate(name);
   flush_cache();
   return 0;
 }
@@ -203,6 +546,7 @@ int SwigType_typedef_class(const_String_or_char_ptr name) {
   cname = NewString(name);
   Setmeta(cname, "class", "1");
   Setattr(current_typetab, cname, cname);
+  typedef_cache_invalidate(cname);
   Delete(cname);
   flush_cache();
   return 0;
@@ -252,11 +596,13 @@ void SwigType_new_scope(const_String_or_char_ptr name) {
   qname = SwigType_scope_name(s);
   Setattr(scopes, qname, s);
   Setattr(s, "qname", qname);
+  typedef_cache_invalidate(qname);
   Delete(qname);
 
   current_scope = s;
   current_typetab = ttab;
   current_symtab = 0;
+  typedef_cache_set_scope();
   flush_cache();
 }
 
@@ -285,6 +631,7 @@ void SwigType_inherit_scope(Typetab *scope) {
       return;
   }
   Append(inherits, scope);
+  typedef_cache_invalidate_scope(current_scope);
 }
 
 /* -----------------------------------------------------------------------------
@@ -302,6 +649,7 @@ void SwigType_scope_alias(String *aliasname, Typetab *ttab) {
   }
   Append(q, aliasname);
   Setattr(scopes, q, ttab);
+  typedef_cache_invalidate(q);
   flush_cache();
 }
 
@@ -331,6 +679,7 @@ void SwigType_using_scope(Typetab *scope) {
     }
     Append(ulist, scope);
   }
+  typedef_cache_invalidate_scope(current_scope);
   flush_cache();
 }
 
@@ -349,6 +698,7 @@ Typetab *SwigType_pop_scope() {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
+  typedef_cache_set_scope();
   flush_cache();
   return old;
 }
@@ -366,6 +716,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
+  typedef_cache_set_scope();
   flush_cache();
   return old;
 }
@@ -424,7 +775,9 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
   Setmark(s, 1);
 
   if (SwigType_istemplate(nameprefix)) {
+    typedef_cache_nostore++;
     nnameprefix = SwigType_typedef_resolve_all(nameprefix);
+    typedef_cache_nostore--;
     nameprefix = nnameprefix;
   }
 
@@ -437,6 +790,7 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
     } else {
       full = NewString(nameprefix);
     }
+    typedef_cache_depend(full);
     if (Getattr(scopes, full)) {
       s = Getattr(scopes, full);
     } else {
@@ -452,6 +806,7 @@ static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
     if (!s) {
       /* Check inheritance */
       List *inherit;
+      typedef_cache_depend_scope(ss);
       inherit = Getattr(ss, "using");
       if (inherit) {
 	Typetab *ttab;
@@ -507,12 +862,14 @@ static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
     Setmark(s, 1);
 
     ttab = Getattr(s, "typetab");
+    typedef_cache_depend(base);
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
       Setmark(s, 0);
     } else {
       /* Hmmm. Not found in my scope.  It could be in an inherited scope */
+      typedef_cache_depend_scope(s);
       inherit = Getattr(s, "inherit");
       if (inherit) {
 	int i, len;
@@ -604,18 +961,22 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   String *namebase = 0;
   String *nameprefix = 0;
   int newtype = 0;
+#ifdef SWIG_TYPEDEF_RESOLVE_CACHE
+  Hash *cache = typedef_resolve_cache;
+  Hash *entry;
+  Hash *outer_deps;
+#endif
 
   resolved_scope = 0;
 
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  if (!typedef_resolve_cache) {
-    typedef_resolve_cache = NewHash();
-  }
-  r = Getattr(typedef_resolve_cache, t);
-  if (r) {
-    resolved_scope = Getmeta(r, "scope");
-    return Copy(r);
+  entry = typedef_cache_get(cache, t, &typedef_resolve_stats);
+  if (entry) {
+    r = Getattr(entry, k_value);
+    resolved_scope = Getattr(entry, k_scope);
+    return r ? Copy(r) : 0;
   }
+  outer_deps = typedef_cache_begin();
 #endif
 
   base = SwigType_base(t);
@@ -634,6 +995,7 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
       Delitem(base, 0);
     }
     /* Do a quick check in the local scope */
+    typedef_cache_depend(base);
     type = Getattr(ttab, base);
     if (type) {
       resolved_scope = s;
@@ -860,18 +1222,9 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
 
 return_result:
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  {
-    String *key = NewString(t);
-    if (r) {
-      SwigType *r1;
-      Setattr(typedef_resolve_cache, key, r);
-      Setmeta(r, "scope", resolved_scope);
-      r1 = Copy(r);
-      Delete(r);
-      r = r1;
-    }
-    Delete(key);
-  }
+  entry = typedef_cache_end(cache, t, r, outer_deps);
+  if (entry)
+    Setattr(entry, k_scope, resolved_scope);
 #endif
   return r;
 }
@@ -886,15 +1239,16 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
   SwigType *n;
   SwigType *r;
   int count = 0;
+  Hash *cache = typedef_all_cache;
+  Hash *entry;
+  Hash *outer_deps;
 
   /* Check to see if the typedef resolve has been done before by checking the cache */
-  if (!typedef_all_cache) {
-    typedef_all_cache = NewHash();
-  }
-  r = Getattr(typedef_all_cache, t);
-  if (r) {
-    return Copy(r);
+  entry = typedef_cache_get(cache, t, &typedef_all_stats);
+  if (entry) {
+    return Copy(Getattr(entry, k_value));
   }
+  outer_deps = typedef_cache_begin();
 
   /* Recursively resolve the typedef */
   r = NewString(t);
@@ -908,14 +1262,7 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
   }
 
   /* Add the typedef to the cache for next time it is looked up */
-  {
-    String *key;
-    SwigType *rr = Copy(r);
-    key = NewString(t);
-    Setattr(typedef_all_cache, key, rr);
-    Delete(key);
-    Delete(rr);
-  }
+  typedef_cache_end(cache, t, r, outer_deps);
   return r;
 }
 
@@ -933,14 +1280,15 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
   List *elements;
   String *result;
   int i, len;
+  Hash *cache = typedef_qualified_cache;
+  Hash *entry;
+  Hash *outer_deps;
 
-  if (!typedef_qualified_cache)
-    typedef_qualified_cache = NewHash();
-  result = Getattr(typedef_qualified_cache, t);
-  if (result) {
-    String *rc = Copy(result);
-    return rc;
+  entry = typedef_cache_get(cache, t, &typedef_qualified_stats);
+  if (entry) {
+    return Copy(Getattr(entry, k_value));
   }
+  outer_deps = typedef_cache_begin();
 
   result = NewStringEmpty();
   elements = SwigType_split(t);
@@ -991,6 +1339,7 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
 		Append(qs, "::");
 	      }
 	      Append(qs, e);
+	      typedef_cache_depend(qs);
 	      if (Getattr(scopes, qs)) {
 		Clear(e);
 		Append(e, qs);
@@ -1120,14 +1469,7 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
     }
   }
   Delete(elements);
-  {
-    String *key, *cresult;
-    key = NewString(t);
-    cresult = NewString(result);
-    Setattr(typedef_qualified_cache, key, cresult);
-    Delete(key);
-    Delete(cresult);
-  }
+  typedef_cache_end(cache, t, result, outer_deps);
   return result;
 }
 
@@ -1184,6 +1526,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 
   /* We set up a typedef  B --> A::B */
   Setattr(current_typetab, base, name);
+  typedef_cache_invalidate(base);
 
   /* Find the scope name where the symbol is defined */
   td = SwigType_typedef_resolve(name);
@@ -1211,6 +1554,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 	Hash *ttab = Getattr(s, "typetab");
 	if (!Getattr(ttab, base) && defined_name) {
 	  Setattr(ttab, base, defined_name);
+	  typedef_cache_invalidate(base);
 	}
       }
     }
@@ -2090,7 +2434,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
     }
     Delete(nthash);
 
-    Printf(types, "\"%s\", \"%s\", 0, 0, (void*)%s, 0};\n", ki.item, nt, cd);
+    Printf(types, "\"%s\", \"%s\", 0, 0, (void*)%s, 0, 0};\n", ki.item, nt, cd);
 
     el = SwigType_equivalent_mangle(ki.item, 0, 0);
     for (ei = First(el); ei.item; ei = Next(ei)) {
@@ -2106,7 +2450,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
       Delete(ckey);
 
       if (!Getattr(r_mangled, ei.item) && !Getattr(imported_types, ei.item)) {
-	Printf(types, "static swig_type_info _swigt_%s = {\"%s\", 0, 0, 0, 0, 0};\n", ei.item, ei.item);
+	Printf(types, "static swig_type_info _swigt_%s = {\"%s\", 0, 0, 0, 0, 0, 0};\n", ei.item, ei.item);
 	Append(table_list, ei.item);
 
 	Printf(cast, "static swig_cast_info _swigc_%s[] = {{&_swigt_%s, 0, 0, 0},{0, 0, 0, 0}};\n", ei.item, ei.item);